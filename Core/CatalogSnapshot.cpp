@@ -0,0 +1,134 @@
+/*
+CatalogSnapshot class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "CatalogSnapshot.hpp"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include "../Utils/SQLiteUtil.hpp"
+
+namespace {
+
+// SQLite database header, it holds the file change counter
+constexpr qint64 SQLiteHeaderSize = 100;
+
+}
+
+QString CatalogSnapshot::defaultPath() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("CatalogSnapshot.bin");
+}
+
+ProgramCatalog CatalogSnapshot::load(const QSqlDatabase &db, const QString &snapshotPath) {
+    ProgramCatalog catalog;
+    const QString databasePath = SQLiteUtil::databaseFilePath(db);
+    if (read(snapshotPath, databasePath, catalog))
+        return catalog;
+
+    catalog = ProgramCatalog::load(db);
+    if (!catalog.isEmpty() && !write(snapshotPath, databasePath, catalog))
+        qDebug() << "Katalog önbelleği yazılamadı:" << snapshotPath;
+    return catalog;
+}
+
+bool CatalogSnapshot::read(const QString &snapshotPath, const QString &databasePath, ProgramCatalog &catalog) {
+    const QByteArray fingerprint = databaseFingerprint(databasePath);
+    if (fingerprint.isEmpty())
+        return false;
+
+    QFile file(snapshotPath);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+        return false;
+
+    uchar *mapped = file.map(0, file.size());
+    if (mapped == nullptr)
+        return false;
+
+    bool ok = false;
+    {
+        // Reads straight from the mapping, the file is not copied into memory first
+        const QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), int(file.size()));
+        QDataStream in(data);
+        in.setVersion(QDataStream::Qt_5_12);
+
+        quint32 magic = 0;
+        quint32 version = 0;
+        QByteArray storedFingerprint;
+        in >> magic >> version;
+        if (magic == Magic && version == Version) {
+            in >> storedFingerprint;
+            if (storedFingerprint == fingerprint) {
+                ProgramCatalog snapshot;
+                quint32 universityCount = 0;
+                in >> universityCount;
+                snapshot.universities.reserve(int(universityCount));
+                for (quint32 i = 0; i < universityCount && in.status() == QDataStream::Ok; i++) {
+                    ProgramCatalog::University university;
+                    qint32 id = 0;
+                    in >> id >> university.name;
+                    university.id = id;
+                    snapshot.universities.append(university);
+                }
+                in >> snapshot.departments;
+
+                ok = in.status() == QDataStream::Ok;
+                if (ok)
+                    catalog = snapshot;
+            }
+        }
+    }
+
+    file.unmap(mapped);
+    return ok;
+}
+
+bool CatalogSnapshot::write(const QString &snapshotPath, const QString &databasePath, const ProgramCatalog &catalog) {
+    const QByteArray fingerprint = databaseFingerprint(databasePath);
+    if (fingerprint.isEmpty())
+        return false;
+
+    QDir().mkpath(QFileInfo(snapshotPath).absolutePath());
+    // Written to a temporary file and renamed, a reader never sees half a snapshot
+    QSaveFile file(snapshotPath);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << Magic << Version << fingerprint;
+    out << quint32(catalog.universities.size());
+    for (const ProgramCatalog::University &university : catalog.universities)
+        out << qint32(university.id) << university.name;
+    out << catalog.departments;
+
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+QByteArray CatalogSnapshot::databaseFingerprint(const QString &databasePath) {
+    const QFileInfo info(databasePath);
+    if (!info.exists())
+        return QByteArray();
+
+    QFile file(databasePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.canonicalFilePath().toUtf8());
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    hash.addData(file.read(SQLiteHeaderSize));
+    return hash.result();
+}
@@ -0,0 +1,40 @@
+/*
+CatalogSnapshot class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QSqlDatabase>
+#include <QString>
+#include "ProgramCatalog.hpp"
+
+// Binary cache of the sorted ProgramCatalog, so the combo boxes are filled
+// without the catalog queries and collator sorts at every launch.
+// A snapshot belongs to one database file state (size, modification time and
+// the SQLite header, whose change counter moves with every write) and is
+// rewritten when the database changes. It is read through a memory map.
+class CatalogSnapshot
+{
+public:
+    static constexpr quint32 Magic = 0x41534353; // "ASCS"
+    // Increase when the file layout or the order of the lists changes
+    static constexpr quint32 Version = 2;
+
+    static QString defaultPath();
+
+    // Returns the snapshot of databasePath, creating it from db when missing or outdated
+    static ProgramCatalog load(const QSqlDatabase &db, const QString &snapshotPath = defaultPath());
+
+    static bool read(const QString &snapshotPath, const QString &databasePath, ProgramCatalog &catalog);
+    static bool write(const QString &snapshotPath, const QString &databasePath, const ProgramCatalog &catalog);
+
+    // Changes with every write to the database file, empty if it cannot be read
+    static QByteArray databaseFingerprint(const QString &databasePath);
+};
@@ -0,0 +1,305 @@
+/*
+EkYerlestirmeParser class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "EkYerlestirmeParser.hpp"
+#include <QDebug>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QStringList>
+#include <cmath>
+#include "../Utils/StringUtil.hpp"
+
+namespace {
+
+// Fields of a record in the 15-field layout
+enum Field {
+    ProgramKoduField = 0,
+    UniversiteField,
+    FakulteField,
+    ProgramField,
+    OgrenimSuresiField,
+    PuanTuruField,
+    GenelKontenjanField,
+    SehitGaziKontenjanField,
+    Kadin34KontenjanField,
+    DepremzedeKontenjanField,
+    OzelKosulField,
+    GenelPuanField,
+    SehitGaziPuanField,
+    Kadin34PuanField,
+    DepremzedePuanField,
+    FieldCount
+};
+
+// The raw ÖSYM export has one more, always empty, field before the scores
+constexpr int RawFieldCount = FieldCount + 1;
+
+// Average size of a program line in the exports, for reserving the rows
+constexpr qint64 BytesPerRow = 150;
+
+// Program codes have nine digits
+constexpr qint64 MinProgramKodu = 100000000;
+constexpr qint64 MaxProgramKodu = 999999999;
+
+int kontenjanValue(const TsvField &field) {
+    double value = 0;
+    if (!EkYerlestirmeParser::parseNumber(field, value) || value < 0 || value != std::floor(value))
+        return EkYerlestirmeRow::NoKontenjan;
+    return int(value);
+}
+
+double puanValue(const TsvField &field) {
+    double value = 0;
+    if (!EkYerlestirmeParser::parseNumber(field, value))
+        return std::numeric_limits<double>::quiet_NaN();
+    return value;
+}
+
+// Calling codes of the countries of the yurt dışı universities, keyed by the
+// country at the end of "(TÜRKİSTAN-KAZAKİSTAN)*"
+int yurtdisiUlkeKodu(const QString &universiteAdi) {
+    static const QList<QPair<QString, int>> countries = {
+        {QStringLiteral("KAZAKİSTAN"), 7},
+        {QStringLiteral("KIRGIZİSTAN"), 996},
+        {QStringLiteral("HERSEK"), 387}
+    };
+    for (const auto &country : countries) {
+        if (universiteAdi.contains(country.first))
+            return country.second;
+    }
+    // Unknown country, still listed under Yurt dışı
+    return 0;
+}
+
+QVariant kontenjanVariant(int value) {
+    return value == EkYerlestirmeRow::NoKontenjan ? QVariant() : QVariant(value);
+}
+
+QVariant puanVariant(double value) {
+    return std::isnan(value) ? QVariant() : QVariant(value);
+}
+
+QVariant textVariant(const QString &value) {
+    return value.isEmpty() ? QVariant() : QVariant(value);
+}
+
+}
+
+const QList<EkYerlestirmeParser::Column> &EkYerlestirmeParser::columns() {
+    static const QList<Column> columns = {
+        {"ProgramKodu",            "INTEGER", [](const EkYerlestirmeRow &r) { return QVariant(r.programKodu); }},
+        {"UniversiteAdi",          "TEXT",    [](const EkYerlestirmeRow &r) { return QVariant(r.universiteAdi); }},
+        {"FakulteYuksekokulAdi",   "TEXT",    [](const EkYerlestirmeRow &r) { return QVariant(r.fakulteYuksekokulAdi); }},
+        {"ProgramAdi",             "TEXT",    [](const EkYerlestirmeRow &r) { return QVariant(r.programAdi); }},
+        {"OgrenimSuresi",          "INTEGER", [](const EkYerlestirmeRow &r) { return QVariant(r.ogrenimSuresi); }},
+        {"PuanTuru",               "TEXT",    [](const EkYerlestirmeRow &r) { return QVariant(r.puanTuru); }},
+        {"UlkeKodu",               "INTEGER", [](const EkYerlestirmeRow &r) { return QVariant(r.ulkeKodu); }},
+        {"DevletUniversitesi",     "BOOLEAN", [](const EkYerlestirmeRow &r) { return QVariant(r.devletUniversitesi ? 1 : 0); }},
+        {"Lisans",                 "BOOLEAN", [](const EkYerlestirmeRow &r) { return QVariant(r.lisans ? 1 : 0); }},
+        {"UcretDurumu",            "INTEGER", [](const EkYerlestirmeRow &r) { return QVariant(r.ucretDurumu); }},
+        {"KKTCUyruklu",            "BOOLEAN", [](const EkYerlestirmeRow &r) { return QVariant(r.kktcUyruklu ? 1 : 0); }},
+        {"MTOK",                   "BOOLEAN", [](const EkYerlestirmeRow &r) { return QVariant(r.mtok ? 1 : 0); }},
+        {"GenelKontenjan",         "INTEGER", [](const EkYerlestirmeRow &r) { return kontenjanVariant(r.genelKontenjan); }},
+        {"SehitGaziKontenjan",     "INTEGER", [](const EkYerlestirmeRow &r) { return kontenjanVariant(r.sehitGaziKontenjan); }},
+        {"Kadin34Kontenjan",       "INTEGER", [](const EkYerlestirmeRow &r) { return kontenjanVariant(r.kadin34Kontenjan); }},
+        {"DepremzedeKontenjan",    "INTEGER", [](const EkYerlestirmeRow &r) { return kontenjanVariant(r.depremzedeKontenjan); }},
+        {"OzelKosulVeAciklamalar", "TEXT",    [](const EkYerlestirmeRow &r) { return textVariant(r.ozelKosulVeAciklamalar); }},
+        {"GenelEnKucukPuan",       "REAL",    [](const EkYerlestirmeRow &r) { return puanVariant(r.genelEnKucukPuan); }},
+        {"SehitGaziEnKucukPuan",   "REAL",    [](const EkYerlestirmeRow &r) { return puanVariant(r.sehitGaziEnKucukPuan); }},
+        {"Kadin34EnKucukPuan",     "REAL",    [](const EkYerlestirmeRow &r) { return puanVariant(r.kadin34EnKucukPuan); }},
+        {"DepremzedeEnKucukPuan",  "REAL",    [](const EkYerlestirmeRow &r) { return puanVariant(r.depremzedeEnKucukPuan); }}
+    };
+    return columns;
+}
+
+QString EkYerlestirmeParser::Arena::intern(const QString &text) {
+    auto it = strings.constFind(text);
+    if (it != strings.constEnd())
+        return *it;
+    strings.insert(text);
+    return text;
+}
+
+bool EkYerlestirmeParser::parseFile(const QString &path, Arena &arena) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Dosya açılamadı:" << path << file.errorString();
+        return false;
+    }
+    if (file.size() == 0)
+        return true;
+
+    // The tokenizer reads straight from the mapping, the file is not copied into memory
+    const uchar *mapped = file.map(0, file.size());
+    if (mapped != nullptr) {
+        parse(reinterpret_cast<const char *>(mapped), file.size(), arena);
+        file.unmap(const_cast<uchar *>(mapped));
+    }
+    else {
+        const QByteArray data = file.readAll();
+        parse(data.constData(), data.size(), arena);
+    }
+    return true;
+}
+
+void EkYerlestirmeParser::parse(const char *data, qint64 size, Arena &arena) {
+    Statistics &counts = arena.statistics;
+    arena.rows.reserve(int(arena.rows.size() + size / BytesPerRow));
+
+    TsvReader reader(data, size);
+    TsvRecord fields;
+    TsvRecord continuation;
+    // Owns the joined text of program names that were broken onto the next line
+    QList<QByteArray> joinedFields;
+
+    while (reader.next(fields)) {
+        counts.records++;
+        qint64 programKodu = 0;
+        if (!parseProgramKodu(fields[0], programKodu)) {
+            // Titles, headers and page numbers
+            counts.skippedRecords++;
+            continue;
+        }
+
+        // The raw export breaks long program names without quoting them, the
+        // rest of the record continues on the next line
+        joinedFields.clear();
+        while (fields.size() < FieldCount && reader.next(continuation)) {
+            counts.records++;
+            joinedFields.append(fields.last().bytes() + ' ' + continuation[0].bytes());
+            TsvField &joined = fields.last();
+            joined.data = joinedFields.last().constData();
+            joined.size = joinedFields.last().size();
+            joined.quoted = false;
+            for (int i = 1; i < continuation.size(); i++)
+                fields.append(continuation[i]);
+        }
+
+        if (fields.size() == RawFieldCount && fields[OzelKosulField + 1].isEmpty())
+            fields.remove(OzelKosulField + 1);
+
+        EkYerlestirmeRow row;
+        if (fields.size() != FieldCount || !parseRecord(fields, row, arena)) {
+            qDebug() << "Satır" << reader.line() << "okunamadı, alan sayısı:" << fields.size();
+            counts.skippedRecords++;
+            continue;
+        }
+        arena.rows.append(row);
+        counts.rows++;
+    }
+}
+
+bool EkYerlestirmeParser::parseProgramKodu(const TsvField &field, qint64 &programKodu) {
+    const QByteArray bytes = QByteArray::fromRawData(field.data, field.size);
+    bool ok = false;
+    qint64 value = bytes.trimmed().toLongLong(&ok);
+    if (!ok) {
+        // Spreadsheets write long numbers in scientific notation
+        double number = 0;
+        if (!parseNumber(field, number) || number != std::floor(number))
+            return false;
+        value = qint64(number);
+    }
+    if (value < MinProgramKodu || value > MaxProgramKodu)
+        return false;
+    programKodu = value;
+    return true;
+}
+
+bool EkYerlestirmeParser::parseNumber(const TsvField &field, double &value) {
+    // Numbers are short, they are normalized on the stack
+    char buffer[64];
+    int length = 0;
+    for (int i = 0; i < field.size; i++) {
+        const char c = field.data[i];
+        if (c == ' ' || c == '\r' || c == '"')
+            continue;
+        if (length == int(sizeof(buffer)))
+            return false;
+        buffer[length++] = c == ',' ? '.' : c;
+    }
+    if (length == 0)
+        return false;
+
+    bool ok = false;
+    value = QByteArray::fromRawData(buffer, length).toDouble(&ok);
+    return ok && std::isfinite(value);
+}
+
+QString EkYerlestirmeParser::normalizeList(const QString &text) {
+    QStringList values = text.split(QLatin1Char(','));
+    for (QString &value : values)
+        value = value.trimmed();
+    values.removeAll(QString());
+    return values.join(QStringLiteral(", "));
+}
+
+bool EkYerlestirmeParser::parseRecord(const TsvRecord &fields, EkYerlestirmeRow &row, Arena &arena) {
+    if (!parseProgramKodu(fields[ProgramKoduField], row.programKodu))
+        return false;
+
+    row.universiteAdi = arena.intern(fields[UniversiteField].text());
+    row.fakulteYuksekokulAdi = arena.intern(fields[FakulteField].text());
+    // Processed files indent the program names
+    row.programAdi = fields[ProgramField].text().simplified();
+    row.puanTuru = arena.intern(StringUtil::toTurkishUpperCase(fields[PuanTuruField].text()));
+
+    double ogrenimSuresi = 0;
+    if (parseNumber(fields[OgrenimSuresiField], ogrenimSuresi))
+        row.ogrenimSuresi = int(ogrenimSuresi);
+
+    row.genelKontenjan = kontenjanValue(fields[GenelKontenjanField]);
+    row.sehitGaziKontenjan = kontenjanValue(fields[SehitGaziKontenjanField]);
+    row.kadin34Kontenjan = kontenjanValue(fields[Kadin34KontenjanField]);
+    row.depremzedeKontenjan = kontenjanValue(fields[DepremzedeKontenjanField]);
+    row.ozelKosulVeAciklamalar = normalizeList(fields[OzelKosulField].text());
+
+    row.genelEnKucukPuan = puanValue(fields[GenelPuanField]);
+    row.sehitGaziEnKucukPuan = puanValue(fields[SehitGaziPuanField]);
+    row.kadin34EnKucukPuan = puanValue(fields[Kadin34PuanField]);
+    row.depremzedeEnKucukPuan = puanValue(fields[DepremzedePuanField]);
+
+    if (row.universiteAdi.isEmpty() || row.programAdi.isEmpty())
+        return false;
+    deriveColumns(row);
+    return true;
+}
+
+void EkYerlestirmeParser::deriveColumns(EkYerlestirmeRow &row) {
+    const QString &universite = row.universiteAdi;
+    const QString &program = row.programAdi;
+
+    // "(Devlet Üniversitesi)" / "(Vakıf Üniversitesi)" only follow universities in Türkiye
+    row.devletUniversitesi = universite.endsWith(QStringLiteral("(Devlet Üniversitesi)"));
+    if (row.devletUniversitesi || universite.endsWith(QStringLiteral("(Vakıf Üniversitesi)")))
+        row.ulkeKodu = 90;
+    else if (universite.contains(QStringLiteral("(KKTC-")))
+        row.ulkeKodu = 357;
+    else
+        row.ulkeKodu = yurtdisiUlkeKodu(universite);
+
+    // Ön lisans programs take two years
+    row.lisans = row.ogrenimSuresi > 2;
+
+    // The application only tells ücretsiz, indirimli and ücretli apart, %25 indirimli counts as indirimli.
+    // Untagged programs are free at devlet and the intergovernmental (*) universities.
+    if (program.contains(QStringLiteral("(Ücretli)")))
+        row.ucretDurumu = 100;
+    else if (program.contains(QStringLiteral("İndirimli)")))
+        row.ucretDurumu = 50;
+    else if (program.contains(QStringLiteral("(Burslu)")) || row.devletUniversitesi || universite.endsWith(QLatin1Char('*')))
+        row.ucretDurumu = 0;
+    else
+        row.ucretDurumu = 100;
+
+    row.kktcUyruklu = program.contains(QStringLiteral("(KKTC Uyruklu)"));
+    row.mtok = program.contains(QStringLiteral("(M.T.O.K.)"));
+}
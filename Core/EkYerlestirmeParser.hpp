@@ -0,0 +1,107 @@
+/*
+EkYerlestirmeParser class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QSet>
+#include <QList>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <limits>
+#include "TsvReader.hpp"
+
+// One program of an ÖSYM ek yerleştirme table, with the columns of EkTercihDetayli.
+// NULL is -1 for the quotas and NaN for the scores.
+struct EkYerlestirmeRow {
+    static constexpr int NoKontenjan = -1;
+
+    qint64 programKodu = 0;
+    QString universiteAdi;
+    QString fakulteYuksekokulAdi;
+    QString programAdi;
+    int ogrenimSuresi = 0;
+    QString puanTuru;
+
+    int genelKontenjan = NoKontenjan;
+    int sehitGaziKontenjan = NoKontenjan;
+    int kadin34Kontenjan = NoKontenjan;
+    int depremzedeKontenjan = NoKontenjan;
+    // Codes of the special conditions, "5, 320"
+    QString ozelKosulVeAciklamalar;
+
+    double genelEnKucukPuan = std::numeric_limits<double>::quiet_NaN();
+    double sehitGaziEnKucukPuan = std::numeric_limits<double>::quiet_NaN();
+    double kadin34EnKucukPuan = std::numeric_limits<double>::quiet_NaN();
+    double depremzedeEnKucukPuan = std::numeric_limits<double>::quiet_NaN();
+
+    // Derived from the university and program names, the exports have no such columns
+    int ulkeKodu = 90;
+    bool devletUniversitesi = false;
+    bool lisans = false;
+    int ucretDurumu = 0;
+    bool kktcUyruklu = false;
+    bool mtok = false;
+};
+
+// Reads the tab separated exports of the ÖSYM ek yerleştirme tables
+// (EkYerlestirme/Tablo3.csv, Tablo4.csv, tablo3_25092025.csv ...) in the
+// three layouts they come in:
+//  - raw ÖSYM export, no header, 16 fields with an empty one before the scores,
+//    "1.10410349E8" program codes and comma decimals, and program names
+//    broken onto a second line
+//  - hand-processed P1 files, a quoted multi-line Turkish header, 15 fields
+//  - processed files with a ProgramKodu ... header, 15 fields, dot decimals
+// Titles, page headers and other lines without a program code are skipped.
+class EkYerlestirmeParser
+{
+public:
+    // A column of EkTercihDetayli and how it is filled from a parsed row
+    struct Column {
+        const char *name;
+        const char *type;
+        QVariant (*value)(const EkYerlestirmeRow &row);
+    };
+
+    struct Statistics {
+        int records = 0;
+        int rows = 0;
+        int skippedRecords = 0;
+    };
+
+    // Output of a parse. Every thread parses into its own arena, so no state
+    // is shared while parsing, and the arenas are merged afterwards.
+    struct Arena {
+        QVector<EkYerlestirmeRow> rows;
+        Statistics statistics;
+        // University, faculty and score type names repeat thousands of times,
+        // the rows share one copy of each
+        QSet<QString> strings;
+
+        QString intern(const QString &text);
+    };
+
+    // The columns a row fills, ProgramKodu first
+    static const QList<Column> &columns();
+
+    static bool parseFile(const QString &path, Arena &arena);
+    static void parse(const char *data, qint64 size, Arena &arena);
+
+    // 110410349 and 1.10410349E8 are both accepted
+    static bool parseProgramKodu(const TsvField &field, qint64 &programKodu);
+    // Accepts both 306,44961 and 306.44961
+    static bool parseNumber(const TsvField &field, double &value);
+    // "5,320" and "5, 320 " both become "5, 320"
+    static QString normalizeList(const QString &text);
+
+private:
+    static bool parseRecord(const TsvRecord &fields, EkYerlestirmeRow &row, Arena &arena);
+    static void deriveColumns(EkYerlestirmeRow &row);
+};
@@ -0,0 +1,44 @@
+/*
+PreparedQueryCache class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "PreparedQueryCache.hpp"
+#include <QDebug>
+#include <QSqlError>
+
+PreparedQueryCache::PreparedQueryCache(int capacity)
+{
+    // Every statement costs 1, so the cache holds at most capacity statements
+    queries.setMaxCost(capacity);
+}
+
+QSqlQuery *PreparedQueryCache::acquire(const QSqlDatabase &db, const QString &sql) {
+    const QString key = db.connectionName() + QLatin1Char('\n') + sql;
+
+    if (QSqlQuery *query = queries.object(key)) {
+        hitCount++;
+        return query;
+    }
+
+    missCount++;
+    auto *query = new QSqlQuery(db);
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        qDebug() << "Sorgu hazırlanamadı:" << query->lastError().text();
+        delete query;
+        return nullptr;
+    }
+
+    queries.insert(key, query);
+    return query;
+}
+
+void PreparedQueryCache::clear() {
+    queries.clear();
+}
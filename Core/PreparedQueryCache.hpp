@@ -0,0 +1,39 @@
+/*
+PreparedQueryCache class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QCache>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+
+// Least recently used set of prepared statements of one connection,
+// keyed by the statement text. A hit skips SQLite's parsing and planning.
+class PreparedQueryCache
+{
+public:
+    static constexpr int DefaultCapacity = 32;
+
+    explicit PreparedQueryCache(int capacity = DefaultCapacity);
+
+    // Returns the prepared query of sql, or nullptr if it cannot be prepared.
+    // The pointer stays valid until the next acquire() or clear() call.
+    QSqlQuery *acquire(const QSqlDatabase &db, const QString &sql);
+    void clear();
+
+    int hits() const { return hitCount; }
+    int misses() const { return missCount; }
+
+private:
+    QCache<QString, QSqlQuery> queries;
+    int hitCount = 0;
+    int missCount = 0;
+};
@@ -0,0 +1,36 @@
+/*
+ProgramCatalog class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// University and department lists of the search combo boxes, in Turkish alphabetical order.
+// The combo boxes show them in this order, they are not sorted again.
+struct ProgramCatalog
+{
+    struct University {
+        int id = 0;
+        QString name;
+    };
+
+    QVector<University> universities;
+    QStringList departments;
+
+    static QVector<University> loadUniversities(const QSqlDatabase &db);
+    // Program names without their "(...)" details, each listed once
+    static QStringList loadDepartments(const QSqlDatabase &db);
+    static ProgramCatalog load(const QSqlDatabase &db);
+
+    bool isEmpty() const { return universities.isEmpty() && departments.isEmpty(); }
+};
@@ -0,0 +1,371 @@
+/*
+ProgramDelta class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramDelta.hpp"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QPair>
+#include <QSaveFile>
+#include <QSet>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStandardPaths>
+#include <algorithm>
+#include <cmath>
+#include "CatalogSnapshot.hpp"
+#include "PreparedQueryCache.hpp"
+#include "ProgramQueryBuilder.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+#include "../Utils/StringUtil.hpp"
+
+namespace {
+
+const char *const KeyColumn = "ProgramKodu";
+
+}
+
+bool ProgramDeltaEngine::diff(const QSqlDatabase &db, const QString &table, const QStringList &columns,
+                              const QVector<QVariantList> &rows, ProgramDelta &delta) {
+    if (!isProgramTable(table)) {
+        qDebug() << "Yalnızca program tabloları için güncelleme dosyası yazılabilir:" << table;
+        return false;
+    }
+    delta = ProgramDelta();
+    delta.table = table;
+    delta.columns = columns;
+
+    const int keyIndex = int(columns.indexOf(QLatin1String(KeyColumn)));
+    if (keyIndex < 0) {
+        qDebug() << "Karşılaştırma için ProgramKodu sütunu gerekli";
+        return false;
+    }
+    const QStringList existingColumns = tableColumns(db, table);
+    for (const QString &column : columns) {
+        if (!existingColumns.contains(column)) {
+            qDebug() << table << "tablosunda" << column << "sütunu yok";
+            return false;
+        }
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT " + columns.join(", ") + " FROM " + table)) {
+        qDebug() << "Tablo okunamadı:" << table << query.lastError().text();
+        return false;
+    }
+    QHash<qint64, QVariantList> current;
+    while (query.next()) {
+        QVariantList values;
+        values.reserve(columns.size());
+        for (int i = 0; i < columns.size(); i++)
+            values.append(query.value(i));
+        current.insert(values.at(keyIndex).toLongLong(), values);
+    }
+
+    QSet<qint64> released;
+    released.reserve(rows.size());
+    for (const QVariantList &row : rows) {
+        const qint64 programKodu = row.at(keyIndex).toLongLong();
+        released.insert(programKodu);
+
+        auto it = current.constFind(programKodu);
+        if (it == current.constEnd()) {
+            delta.insertedRows.append(row);
+            continue;
+        }
+        for (int i = 0; i < columns.size(); i++) {
+            if (i != keyIndex && !sameValue(it.value().at(i), row.at(i)))
+                delta.changes.append({programKodu, columns.at(i), row.at(i)});
+        }
+    }
+
+    for (auto it = current.constBegin(); it != current.constEnd(); ++it) {
+        if (!released.contains(it.key()))
+            delta.removedPrograms.append(it.key());
+    }
+    std::sort(delta.removedPrograms.begin(), delta.removedPrograms.end());
+    return true;
+}
+
+bool ProgramDeltaEngine::apply(const QSqlDatabase &db, const ProgramDelta &delta) {
+    // The table name ends up in the statements, checked before the database is touched
+    if (!isProgramTable(delta.table)) {
+        qDebug() << "Güncelleme dosyası bir program tablosunu değiştirmiyor:" << delta.table;
+        return false;
+    }
+    // Column names end up in the statements, a delta may only name columns of its table
+    const QStringList existingColumns = tableColumns(db, delta.table);
+    if (existingColumns.isEmpty()) {
+        qDebug() << "Tablo bulunamadı:" << delta.table;
+        return false;
+    }
+    QStringList namedColumns = delta.columns;
+    for (const ProgramDelta::Change &change : delta.changes)
+        namedColumns.append(change.column);
+    for (const QString &column : namedColumns) {
+        if (!existingColumns.contains(column)) {
+            qDebug() << delta.table << "tablosunda" << column << "sütunu yok";
+            return false;
+        }
+    }
+    const int keyIndex = int(delta.columns.indexOf(QLatin1String(KeyColumn)));
+    if (!delta.insertedRows.isEmpty() && keyIndex < 0) {
+        qDebug() << "Eklenen programlarda ProgramKodu sütunu yok";
+        return false;
+    }
+
+    // Sort key columns of the database optimizer follow their text columns
+    QHash<QString, QString> sortKeyColumns;
+    for (const QString &column : SQLiteUtil::turkishSortedColumns()) {
+        const QString keyColumn = SQLiteUtil::sortKeyColumnFor(column);
+        if (existingColumns.contains(column) && existingColumns.contains(keyColumn))
+            sortKeyColumns.insert(column, keyColumn);
+    }
+
+    QSqlDatabase connection(db);
+    if (!connection.transaction()) {
+        qDebug() << "İşlem başlatılamadı:" << connection.lastError().text();
+        return false;
+    }
+
+    PreparedQueryCache statements;
+    const auto run = [&statements, &connection](const QString &sql, const QVariantList &values) {
+        QSqlQuery *query = statements.acquire(connection, sql);
+        if (query == nullptr)
+            return false;
+        for (int i = 0; i < values.size(); i++)
+            query->bindValue(i, values.at(i));
+        if (!query->exec()) {
+            qDebug() << "Güncelleme uygulanamadı:" << sql << query->lastError().text();
+            return false;
+        }
+        return true;
+    };
+    const auto update = [&run, &sortKeyColumns, &delta](qint64 programKodu, const QString &column, const QVariant &value) {
+        if (!run("UPDATE " + delta.table + " SET " + column + " = ? WHERE " + KeyColumn + " = ?", {value, programKodu}))
+            return false;
+        auto keyColumn = sortKeyColumns.constFind(column);
+        if (keyColumn == sortKeyColumns.constEnd())
+            return true;
+        const QVariant key = value.isNull() ? QVariant() : QVariant(StringUtil::toTurkishSortKey(value.toString()));
+        return run("UPDATE " + delta.table + " SET " + keyColumn.value() + " = ? WHERE " + KeyColumn + " = ?", {key, programKodu});
+    };
+
+    bool ok = true;
+    const QString deleteSql = "DELETE FROM " + delta.table + " WHERE " + KeyColumn + " = ?";
+    for (int i = 0; ok && i < delta.removedPrograms.size(); i++)
+        ok = run(deleteSql, {delta.removedPrograms.at(i)});
+
+    if (ok && !delta.insertedRows.isEmpty()) {
+        QStringList placeholders;
+        for (int i = 0; i < delta.columns.size(); i++)
+            placeholders.append(QStringLiteral("?"));
+        const QString insertSql = "INSERT INTO " + delta.table + " (" + delta.columns.join(", ") +
+                                  ") VALUES (" + placeholders.join(", ") + ")";
+
+        for (int i = 0; ok && i < delta.insertedRows.size(); i++) {
+            const QVariantList &row = delta.insertedRows.at(i);
+            const QVariant programKodu = row.at(keyIndex);
+            // Applying the same delta twice must not duplicate the program
+            ok = run(deleteSql, {programKodu}) && run(insertSql, row);
+            for (auto it = sortKeyColumns.constBegin(); ok && it != sortKeyColumns.constEnd(); ++it) {
+                const int column = int(delta.columns.indexOf(it.key()));
+                if (column >= 0)
+                    ok = update(programKodu.toLongLong(), it.key(), row.at(column));
+            }
+        }
+    }
+
+    for (int i = 0; ok && i < delta.changes.size(); i++) {
+        const ProgramDelta::Change &change = delta.changes.at(i);
+        ok = update(change.programKodu, change.column, change.value);
+    }
+
+    // Statements must be released before the transaction ends
+    statements.clear();
+    if (!ok) {
+        connection.rollback();
+        return false;
+    }
+    if (!connection.commit()) {
+        qDebug() << "İşlem tamamlanamadı:" << connection.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool ProgramDeltaEngine::read(const QString &path, ProgramDelta &delta) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != Magic || version != Version) {
+        qDebug() << "Güncelleme dosyası tanınmadı:" << path;
+        return false;
+    }
+
+    delta = ProgramDelta();
+    quint32 changeCount = 0;
+    in >> delta.table >> delta.columns >> delta.insertedRows >> delta.removedPrograms >> changeCount;
+    for (quint32 i = 0; i < changeCount && in.status() == QDataStream::Ok; i++) {
+        ProgramDelta::Change change;
+        in >> change.programKodu >> change.column >> change.value;
+        delta.changes.append(change);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+bool ProgramDeltaEngine::write(const QString &path, const ProgramDelta &delta) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << Magic << Version
+        << delta.table << delta.columns << delta.insertedRows << delta.removedPrograms
+        << quint32(delta.changes.size());
+    for (const ProgramDelta::Change &change : delta.changes)
+        out << change.programKodu << change.column << change.value;
+
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+QString ProgramDeltaEngine::deltaDirectory() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("Deltas");
+}
+
+bool ProgramDeltaEngine::isProgramTable(const QString &table) {
+    return table == ProgramQueryBuilder::tableName(TercihTuru::NormalTercih)
+        || table == ProgramQueryBuilder::tableName(TercihTuru::EkTercih);
+}
+
+bool ProgramDeltaEngine::install(const QString &deltaPath) {
+    ProgramDelta delta;
+    if (!read(deltaPath, delta))
+        return false;
+    if (!isProgramTable(delta.table)) {
+        qDebug() << "Güncelleme dosyası bir program tablosunu değiştirmiyor:" << delta.table;
+        return false;
+    }
+
+    const QDir directory(deltaDirectory());
+    directory.mkpath(".");
+    const QString target = directory.filePath(QFileInfo(deltaPath).fileName());
+    if (QFileInfo(target).canonicalFilePath() == QFileInfo(deltaPath).canonicalFilePath())
+        return true;
+    QFile::remove(target);
+    return QFile::copy(deltaPath, target);
+}
+
+QString ProgramDeltaEngine::patchedDatabase(const QString &databasePath) {
+    const QFileInfoList deltaFiles = QDir(deltaDirectory()).entryInfoList({"*.delta"}, QDir::Files, QDir::Name);
+    if (deltaFiles.isEmpty())
+        return databasePath;
+
+    // The patched copy belongs to one state of the database and of the delta files
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(CatalogSnapshot::databaseFingerprint(databasePath));
+    for (const QFileInfo &deltaFile : deltaFiles) {
+        QFile file(deltaFile.absoluteFilePath());
+        if (file.open(QIODevice::ReadOnly)) {
+            hash.addData(deltaFile.fileName().toUtf8());
+            hash.addData(&file);
+        }
+    }
+    const QByteArray fingerprint = hash.result().toHex();
+
+    const QDir dataDirectory(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    const QString patchedPath = dataDirectory.filePath("YKSGuncel.sqlite");
+    const QString fingerprintPath = patchedPath + ".fingerprint";
+    {
+        QFile stamp(fingerprintPath);
+        if (QFile::exists(patchedPath) && stamp.open(QIODevice::ReadOnly) && stamp.readAll() == fingerprint)
+            return patchedPath;
+    }
+
+    // Built next to the target, a half updated copy is never opened
+    const QString buildPath = patchedPath + ".tmp";
+    QFile::remove(buildPath);
+    if (!QFile::copy(databasePath, buildPath)) {
+        qDebug() << "Veritabanı kopyalanamadı:" << databasePath << "->" << buildPath;
+        return databasePath;
+    }
+    QFile::setPermissions(buildPath, QFile::permissions(buildPath) | QFileDevice::WriteOwner);
+
+    const QString connectionName = QStringLiteral("ProgramDeltaEngine");
+    bool ok = true;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        ok = SQLiteUtil::openDatabase(db, buildPath, SQLiteUtil::writableOptions());
+        for (const QFileInfo &deltaFile : deltaFiles) {
+            ProgramDelta delta;
+            ok = ok && read(deltaFile.absoluteFilePath(), delta) && apply(db, delta);
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+
+    if (!ok) {
+        qDebug() << "Güncelleme dosyaları uygulanamadı, veritabanı güncellenmeden kullanılıyor";
+        QFile::remove(buildPath);
+        return databasePath;
+    }
+
+    QFile::remove(patchedPath);
+    if (!QFile::rename(buildPath, patchedPath))
+        return databasePath;
+
+    QSaveFile stamp(fingerprintPath);
+    if (stamp.open(QIODevice::WriteOnly)) {
+        stamp.write(fingerprint);
+        stamp.commit();
+    }
+    return patchedPath;
+}
+
+bool ProgramDeltaEngine::sameValue(const QVariant &a, const QVariant &b) {
+    // A NULL quota is not 0, QVariant would compare them equal
+    if (a.isNull() || b.isNull())
+        return a.isNull() && b.isNull();
+
+    bool aIsNumber = false;
+    bool bIsNumber = false;
+    const double x = a.toDouble(&aIsNumber);
+    const double y = b.toDouble(&bIsNumber);
+    if (aIsNumber && bIsNumber)
+        return std::fabs(x - y) <= 1e-9 * std::max(1.0, std::fabs(x));
+    return a.toString() == b.toString();
+}
+
+QStringList ProgramDeltaEngine::tableColumns(const QSqlDatabase &db, const QString &table) {
+    QStringList columns;
+    QSqlQuery query(db);
+    if (query.exec("PRAGMA table_info(" + table + ")")) {
+        while (query.next())
+            columns.append(query.value("name").toString());
+    }
+    return columns;
+}
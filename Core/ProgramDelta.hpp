@@ -0,0 +1,74 @@
+/*
+ProgramDelta class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+// Change set between the program table of a database and a new release of
+// the same table, matched by ProgramKodu. Only the fields that differ are kept.
+struct ProgramDelta {
+    struct Change {
+        qint64 programKodu = 0;
+        QString column;
+        QVariant value;
+    };
+
+    QString table;
+    // Columns of insertedRows, the release had these columns
+    QStringList columns;
+    QVector<QVariantList> insertedRows;
+    QVector<qint64> removedPrograms;
+    QVector<Change> changes;
+
+    bool isEmpty() const { return insertedRows.isEmpty() && removedPrograms.isEmpty() && changes.isEmpty(); }
+};
+
+// Computes, stores and applies ProgramDelta change sets. Mid-season ÖSYM
+// revisions reach the application as small delta files instead of a new
+// YKS.sqlite: files copied into deltaDirectory() are applied to a private
+// copy of the shipped database, which is used from then on.
+class ProgramDeltaEngine
+{
+public:
+    static constexpr quint32 Magic = 0x4153444C; // "ASDL"
+    // Increase when the file layout changes
+    static constexpr quint32 Version = 1;
+
+    // rows hold the values of columns, one of them is ProgramKodu.
+    // Programs of table missing from rows are removed.
+    static bool diff(const QSqlDatabase &db, const QString &table, const QStringList &columns,
+                     const QVector<QVariantList> &rows, ProgramDelta &delta);
+    // Applies delta in one transaction, nothing is changed if it fails
+    static bool apply(const QSqlDatabase &db, const ProgramDelta &delta);
+
+    static bool read(const QString &path, ProgramDelta &delta);
+    static bool write(const QString &path, const ProgramDelta &delta);
+
+    // Delta files come from outside, only the program tables of
+    // ProgramQueryBuilder may be named by them
+    static bool isProgramTable(const QString &table);
+
+    static QString deltaDirectory();
+    // Copies a delta file into deltaDirectory(), it is applied at the next start
+    static bool install(const QString &deltaPath);
+    // databasePath itself when there is no delta, otherwise a copy of it with
+    // every delta file of deltaDirectory() applied in file name order. The copy
+    // is only rebuilt when the database or the delta files change.
+    static QString patchedDatabase(const QString &databasePath);
+
+private:
+    static bool sameValue(const QVariant &a, const QVariant &b);
+    static QStringList tableColumns(const QSqlDatabase &db, const QString &table);
+};
@@ -0,0 +1,81 @@
+/*
+ProgramFilter struct declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QString>
+#include "../EnumDefinitions.hpp"
+
+// Snapshot of every filter the program table can be narrowed with.
+// Defaults match the initial state of the filter widgets.
+struct ProgramFilter {
+    static constexpr double EnKucukPuanSiniri = 100.0;
+    static constexpr double EnBuyukPuanSiniri = 560.0;
+
+    TercihTuru tercihTuru = TercihTuru::NormalTercih;
+    QString universityName;
+    QString department;
+
+    Ulke ulke = Ulke::Tumu;
+    LisansTuru lisansTuru = LisansTuru::Tumu;
+    UniversiteTuru universiteTuru = UniversiteTuru::Tumu;
+    PuanTuru puanTuru = PuanTuru::Tumu;
+
+    double enKucukPuan = EnKucukPuanSiniri;
+    double enBuyukPuan = EnBuyukPuanSiniri;
+
+    // Başarı sırası aralığı, both ends inclusive. 0 leaves that end open.
+    int enKucukBasariSirasi = 0;
+    int enBuyukBasariSirasi = 0;
+
+    // Kontenjan türleri
+    bool genel = true;
+    bool okulBirincisi = false;
+    bool sehitGaziYakini = false;
+    bool depremzede = false;
+    bool kadin34 = false;
+    bool kktcUyruklu = false;
+    bool mtok = false;
+
+    // Ücret durumu
+    bool ucretsiz = true;
+    bool indirimli = true;
+    bool ucretli = true;
+
+    // -1 keeps the default ProgramKodu order
+    int sortColumn = -1;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+
+    bool hasKontenjanSelection() const {
+        return genel || okulBirincisi || sehitGaziYakini || depremzede || kadin34 || kktcUyruklu || mtok;
+    }
+
+    bool hasTuitionSelection() const {
+        return ucretsiz || indirimli || ucretli;
+    }
+
+    // False when an empty kontenjan or ücret selection leaves no program to list
+    bool canMatch() const {
+        return hasKontenjanSelection() && hasTuitionSelection();
+    }
+
+    // KKTC uyruklu and M.T.O.K programs are listed with the general quota scores
+    bool includesGenelScores() const {
+        return genel || kktcUyruklu || mtok;
+    }
+
+    bool hasMinimumScore() const { return enKucukPuan > EnKucukPuanSiniri; }
+    bool hasMaximumScore() const { return enBuyukPuan < EnBuyukPuanSiniri; }
+    bool hasScoreRange() const { return hasMinimumScore() || hasMaximumScore(); }
+
+    bool hasMinimumRank() const { return enKucukBasariSirasi > 0; }
+    bool hasMaximumRank() const { return enBuyukBasariSirasi > 0; }
+    bool hasRankRange() const { return hasMinimumRank() || hasMaximumRank(); }
+};
@@ -0,0 +1,228 @@
+/*
+ProgramHistory class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramHistory.hpp"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QUrl>
+#include <algorithm>
+#include "ProgramQueryBuilder.hpp"
+
+namespace {
+
+// Columns of a series, in the order of ProgramYearRecord
+const QStringList &seriesColumns() {
+    static const QStringList columns = {"GenelKontenjan", "GenelYerlesen", "GenelEnKucukPuan", "GenelBasariSirasi"};
+    return columns;
+}
+
+QString schemaName(int yil) {
+    return QStringLiteral("y%1").arg(yil);
+}
+
+QString partitionFileName(int yil) {
+    return QStringLiteral("YKS_%1.sqlite").arg(yil);
+}
+
+double numberOrNaN(const QVariant &value) {
+    bool ok = false;
+    const double number = value.toDouble(&ok);
+    return value.isNull() || !ok ? std::numeric_limits<double>::quiet_NaN() : number;
+}
+
+}
+
+ProgramHistory::ProgramHistory(const QString &historyDirectory)
+    : historyDirectory(historyDirectory)
+    , connectionName(QStringLiteral("ProgramHistory_%1").arg(quintptr(this), 0, 16))
+{
+    static const QRegularExpression fileName(QStringLiteral("^YKS_(\\d{4})\\.sqlite$"));
+    const QStringList files = QDir(historyDirectory).entryList({"YKS_*.sqlite"}, QDir::Files);
+    for (const QString &file : files) {
+        const QRegularExpressionMatch match = fileName.match(file);
+        if (match.hasMatch())
+            yearList.append(match.captured(1).toInt());
+    }
+    std::sort(yearList.begin(), yearList.end());
+}
+
+ProgramHistory::~ProgramHistory() {
+    // Prepared statements must go before their connection
+    statements.clear();
+    if (QSqlDatabase::contains(connectionName)) {
+        QSqlDatabase::database(connectionName, false).close();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+}
+
+QString ProgramHistory::defaultHistoryDirectory(const QString &databasePath) {
+    return QFileInfo(databasePath).absoluteDir().filePath("Gecmis");
+}
+
+QList<int> ProgramHistory::years() const {
+    return yearList;
+}
+
+bool ProgramHistory::isAvailable() const {
+    return !yearList.isEmpty();
+}
+
+QVector<ProgramYearRecord> ProgramHistory::series(qint64 programKodu, TercihTuru tercihTuru) {
+    QVector<ProgramYearRecord> records;
+    if (!open())
+        return records;
+
+    const QString sql = seriesSql(ProgramQueryBuilder::tableName(tercihTuru));
+    if (sql.isEmpty())
+        return records;
+
+    QSqlQuery *query = statements.acquire(QSqlDatabase::database(connectionName, false), sql);
+    if (query == nullptr)
+        return records;
+
+    // Every partition has its own placeholder
+    const int placeholderCount = int(sql.count(QLatin1Char('?')));
+    for (int i = 0; i < placeholderCount; i++)
+        query->bindValue(i, programKodu);
+
+    if (!query->exec()) {
+        qDebug() << "Geçmiş yıllar sorgulanamadı:" << query->lastError().text();
+        return records;
+    }
+    while (query->next()) {
+        ProgramYearRecord record;
+        record.yil = query->value(0).toInt();
+        record.genelKontenjan = numberOrNaN(query->value(1));
+        record.genelYerlesen = numberOrNaN(query->value(2));
+        record.genelEnKucukPuan = numberOrNaN(query->value(3));
+        record.genelBasariSirasi = numberOrNaN(query->value(4));
+        records.append(record);
+    }
+    query->finish();
+    return records;
+}
+
+bool ProgramHistory::open() {
+    if (opened)
+        return !attachedYears.isEmpty();
+    opened = true;
+    if (yearList.isEmpty())
+        return false;
+
+    // An empty in-memory main database, the years are attached to it read-only.
+    // URI file names let ATTACH pass immutable=1 like SQLiteUtil does for the main database.
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setConnectOptions("QSQLITE_OPEN_URI");
+    db.setDatabaseName(":memory:");
+    if (!db.open()) {
+        qDebug() << "Geçmiş yıllar bağlantısı açılamadı:" << db.lastError().text();
+        return false;
+    }
+
+    QList<int> years = yearList;
+    if (years.size() > MaxAttachedYears) {
+        qDebug() << "Geçmiş yıllardan en yeni" << MaxAttachedYears << "yıl kullanılıyor";
+        years = years.mid(years.size() - MaxAttachedYears);
+    }
+
+    QSqlQuery query(db);
+    for (int yil : years) {
+        QUrl uri = QUrl::fromLocalFile(QDir(historyDirectory).absoluteFilePath(partitionFileName(yil)));
+        uri.setQuery("mode=ro&immutable=1");
+        query.prepare("ATTACH DATABASE ? AS " + schemaName(yil));
+        query.bindValue(0, uri.toString(QUrl::FullyEncoded));
+        if (!query.exec()) {
+            qDebug() << yil << "yılı eklenemedi:" << query.lastError().text();
+            continue;
+        }
+        attachedYears.append(yil);
+    }
+    return !attachedYears.isEmpty();
+}
+
+QString ProgramHistory::seriesSql(const QString &table) {
+    auto it = seriesSqlCache.constFind(table);
+    if (it != seriesSqlCache.constEnd())
+        return it.value();
+
+    // Schemas differ between the years, a column a year lacks is selected as NULL
+    QStringList parts;
+    for (int yil : attachedYears) {
+        const QString schema = schemaName(yil);
+        const QStringList columns = partitionColumns(schema, table);
+        if (!columns.contains(QStringLiteral("ProgramKodu")))
+            continue;
+        // A scan of a whole year per lookup, the build indexes every partition
+        if (!hasProgramKoduIndex(schema, table)) {
+            qWarning() << yil << "yılı atlandı," << table << "tablosunda ProgramKodu indeksi yok";
+            continue;
+        }
+
+        QStringList selected = {QString::number(yil) + " AS Yil"};
+        for (const QString &column : seriesColumns())
+            selected.append(columns.contains(column) ? column : "NULL AS " + column);
+        parts.append("SELECT " + selected.join(", ") + " FROM " + schema + "." + table + " WHERE ProgramKodu = ?");
+    }
+
+    QString sql;
+    if (!parts.isEmpty())
+        sql = parts.join(" UNION ALL ") + " ORDER BY Yil";
+    seriesSqlCache.insert(table, sql);
+    return sql;
+}
+
+bool ProgramHistory::hasProgramKoduIndex(const QString &schema, const QString &table) {
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+    // An INTEGER PRIMARY KEY is the rowid itself and has no index of its own
+    QSqlQuery tableInfo(db);
+    if (tableInfo.exec("PRAGMA " + schema + ".table_info(" + table + ")")) {
+        while (tableInfo.next()) {
+            if (tableInfo.value("name").toString() == QLatin1String("ProgramKodu")
+                && tableInfo.value("pk").toInt() == 1
+                && tableInfo.value("type").toString().compare(QLatin1String("INTEGER"), Qt::CaseInsensitive) == 0)
+                return true;
+        }
+    }
+
+    QSqlQuery indexes(db);
+    if (!indexes.exec("PRAGMA " + schema + ".index_list(" + table + ")"))
+        return false;
+    QStringList names;
+    while (indexes.next()) {
+        // A partial index does not cover every program
+        if (indexes.value("partial").toInt() == 0)
+            names.append(indexes.value("name").toString());
+    }
+
+    // The lookup can use any full index that starts with ProgramKodu
+    QSqlQuery columns(db);
+    for (const QString &name : names) {
+        if (columns.exec("PRAGMA " + schema + ".index_info(\"" + name + "\")") && columns.next()
+            && columns.value("name").toString() == QLatin1String("ProgramKodu"))
+            return true;
+    }
+    return false;
+}
+
+QStringList ProgramHistory::partitionColumns(const QString &schema, const QString &table) {
+    QStringList columns;
+    QSqlQuery query(QSqlDatabase::database(connectionName, false));
+    if (query.exec("PRAGMA " + schema + ".table_info(" + table + ")")) {
+        while (query.next())
+            columns.append(query.value("name").toString());
+    }
+    return columns;
+}
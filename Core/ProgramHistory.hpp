@@ -0,0 +1,71 @@
+/*
+ProgramHistory class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <limits>
+#include "PreparedQueryCache.hpp"
+#include "../EnumDefinitions.hpp"
+
+// One year of a program, empty (NULL) values are NaN
+struct ProgramYearRecord {
+    int yil = 0;
+    double genelKontenjan = std::numeric_limits<double>::quiet_NaN();
+    double genelYerlesen = std::numeric_limits<double>::quiet_NaN();
+    double genelEnKucukPuan = std::numeric_limits<double>::quiet_NaN();
+    double genelBasariSirasi = std::numeric_limits<double>::quiet_NaN();
+};
+
+// Earlier years of YKS.sqlite, partitioned by year into one database file each:
+// <history directory>/YKS_2021.sqlite, YKS_2022.sqlite ... Every partition keeps
+// the schema of its year, so a year is added by dropping its file in the directory.
+// The partitions are attached to a connection of their own, opened at the first
+// lookup. The current database, the program store and the filter path never see them.
+class ProgramHistory
+{
+public:
+    // SQLITE_MAX_ATTACHED, the newest years are kept when there are more files
+    static constexpr int MaxAttachedYears = 10;
+
+    explicit ProgramHistory(const QString &historyDirectory);
+    ~ProgramHistory();
+
+    // "Gecmis" next to the database file
+    static QString defaultHistoryDirectory(const QString &databasePath);
+
+    // Years with a partition file, ascending. Does not open the databases.
+    QList<int> years() const;
+    bool isAvailable() const;
+
+    // The years of programKodu in ascending order, years without the program are left out.
+    // One statement over every partition, each answered by its ProgramKodu index.
+    // Partitions without that index (not built by the database optimizer) are skipped.
+    QVector<ProgramYearRecord> series(qint64 programKodu, TercihTuru tercihTuru = TercihTuru::NormalTercih);
+
+private:
+    bool open();
+    QString seriesSql(const QString &table);
+    QStringList partitionColumns(const QString &schema, const QString &table);
+    bool hasProgramKoduIndex(const QString &schema, const QString &table);
+
+    QString historyDirectory;
+    QString connectionName;
+    QList<int> yearList;
+    QList<int> attachedYears;
+    bool opened = false;
+    // Statement text per table, built once from the columns of each partition
+    QHash<QString, QString> seriesSqlCache;
+    PreparedQueryCache statements;
+};
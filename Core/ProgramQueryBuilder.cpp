@@ -0,0 +1,227 @@
+/*
+ProgramQueryBuilder class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramQueryBuilder.hpp"
+#include <QStringList>
+#include "ProgramTable.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+#include "../Utils/StringUtil.hpp"
+
+namespace {
+
+// A WHERE condition together with the values of its placeholders
+struct Condition {
+    QString sql;
+    QVariantList bindings;
+};
+
+// Joins the conditions with op and appends their bindings in the same order
+Condition joinConditions(const QList<Condition> &conditions, const QString &op) {
+    Condition joined;
+    QStringList parts;
+    for (const Condition &condition : conditions) {
+        parts.append(condition.sql);
+        joined.bindings.append(condition.bindings);
+    }
+    joined.sql = parts.join(" " + op + " ");
+    if (op == QLatin1String("OR"))
+        joined.sql = "(" + joined.sql + ")";
+    return joined;
+}
+
+Condition puanAraligiCondition(const ProgramFilter &filter, const QString &column) {
+    QList<Condition> bounds;
+    if (filter.hasMinimumScore())
+        bounds.append({column + " > ?", {filter.enKucukPuan}});
+    if (filter.hasMaximumScore())
+        bounds.append({column + " < ?", {filter.enBuyukPuan}});
+    return joinConditions(bounds, "AND");
+}
+
+Condition basariSirasiAraligiCondition(const ProgramFilter &filter, const QString &column) {
+    QList<Condition> bounds;
+    if (filter.hasMinimumRank())
+        bounds.append({column + " >= ?", {filter.enKucukBasariSirasi}});
+    if (filter.hasMaximumRank())
+        bounds.append({column + " <= ?", {filter.enBuyukBasariSirasi}});
+    return joinConditions(bounds, "AND");
+}
+
+QString puanTuruValue(PuanTuru puanTuru) {
+    switch (puanTuru) {
+    case PuanTuru::SAY: return "SAY";
+    case PuanTuru::EA:  return "EA";
+    case PuanTuru::SOZ: return "SÖZ";
+    case PuanTuru::TYT: return "TYT";
+    case PuanTuru::DIL: return "DİL";
+    default: return QString();
+    }
+}
+
+}
+
+ProgramQuery ProgramQueryBuilder::compile(const ProgramFilter &filter, bool useSortKeyColumns) {
+    QList<Condition> whereConditions;
+    QList<Condition> kontenjanConditions;
+    QList<Condition> tuitionConditions;
+    QList<Condition> gradeIntervalConditions;
+    QList<Condition> rankIntervalConditions;
+
+    if(filter.universityName.trimmed() != "") {
+        whereConditions.append({"UniversiteAdi LIKE ?", {"%" + StringUtil::toTurkishUpperCase(filter.universityName) + "%"}});
+    }
+
+    if(filter.department.trimmed() != "") {
+        whereConditions.append({"ProgramAdi LIKE ?", {"%" + StringUtil::toTurkishTitleCase(filter.department) + "%"}});
+    }
+
+    if(filter.ulke == Ulke::Turkiye) {
+        whereConditions.append({"UlkeKodu = ?", {90}});
+    }
+    else if(filter.ulke == Ulke::KKTC) {
+        whereConditions.append({"UlkeKodu = ?", {357}});
+    }
+    else if(filter.ulke == Ulke::Yurtdisi) {
+        whereConditions.append({"UlkeKodu <> ?", {90}});
+        whereConditions.append({"UlkeKodu <> ?", {357}});
+    }
+
+    if(filter.lisansTuru != LisansTuru::Tumu) {
+        whereConditions.append({"Lisans = ?", {filter.lisansTuru == LisansTuru::Lisans ? 1 : 0}});
+    }
+
+    if(filter.universiteTuru != UniversiteTuru::Tumu) {
+        whereConditions.append({"DevletUniversitesi = ?", {filter.universiteTuru == UniversiteTuru::Devlet ? 1 : 0}});
+    }
+
+    const QString puanTuru = puanTuruValue(filter.puanTuru);
+    if(!puanTuru.isEmpty()) {
+        whereConditions.append({"PuanTuru = ?", {puanTuru}});
+    }
+
+    if(filter.hasScoreRange()) {
+        if(filter.includesGenelScores())
+            gradeIntervalConditions.append(puanAraligiCondition(filter, "GenelEnKucukPuan"));
+        if(filter.okulBirincisi)
+            gradeIntervalConditions.append(puanAraligiCondition(filter, "OkulBirincisiEnKucukPuan"));
+        if(filter.sehitGaziYakini)
+            gradeIntervalConditions.append(puanAraligiCondition(filter, "SehitGaziEnKucukPuan"));
+        if(filter.depremzede)
+            gradeIntervalConditions.append(puanAraligiCondition(filter, "DepremzedeEnKucukPuan"));
+        if(filter.kadin34)
+            gradeIntervalConditions.append(puanAraligiCondition(filter, "Kadin34EnKucukPuan"));
+    }
+
+    if(!gradeIntervalConditions.isEmpty()) {
+        whereConditions.append(joinConditions(gradeIntervalConditions, "OR"));
+    }
+
+    if(filter.hasRankRange()) {
+        if(filter.includesGenelScores())
+            rankIntervalConditions.append(basariSirasiAraligiCondition(filter, "GenelBasariSirasi"));
+        if(filter.okulBirincisi)
+            rankIntervalConditions.append(basariSirasiAraligiCondition(filter, "OkulBirincisiBasariSirasi"));
+        if(filter.sehitGaziYakini)
+            rankIntervalConditions.append(basariSirasiAraligiCondition(filter, "SehitGaziBasariSirasi"));
+        if(filter.depremzede)
+            rankIntervalConditions.append(basariSirasiAraligiCondition(filter, "DepremzedeBasariSirasi"));
+        if(filter.kadin34)
+            rankIntervalConditions.append(basariSirasiAraligiCondition(filter, "Kadin34BasariSirasi"));
+    }
+
+    if(!rankIntervalConditions.isEmpty()) {
+        whereConditions.append(joinConditions(rankIntervalConditions, "OR"));
+    }
+
+    if (filter.genel) {
+        kontenjanConditions.append({"GenelKontenjan IS NOT NULL", {}});
+    }
+
+    if (filter.okulBirincisi) {
+        kontenjanConditions.append({"OkulBirincisiKontenjan IS NOT NULL", {}});
+    }
+
+    if (filter.sehitGaziYakini) {
+        kontenjanConditions.append({"SehitGaziKontenjan IS NOT NULL", {}});
+    }
+
+    if (filter.depremzede) {
+        kontenjanConditions.append({"DepremzedeKontenjan IS NOT NULL", {}});
+    }
+
+    if (filter.kadin34) {
+        kontenjanConditions.append({"Kadin34Kontenjan IS NOT NULL", {}});
+    }
+
+    if (filter.ucretsiz) {
+        tuitionConditions.append({"UcretDurumu = ?", {0}});
+    }
+
+    if (filter.indirimli) {
+        tuitionConditions.append({"UcretDurumu = ?", {50}});
+    }
+
+    if (filter.ucretli) {
+        tuitionConditions.append({"UcretDurumu = ?", {100}});
+    }
+
+    if (filter.kktcUyruklu) {
+        kontenjanConditions.append({"KKTCUyruklu = TRUE", {}}); //In order to add OR Query, it is appended to kontenjanConditions
+    }
+    else {
+        whereConditions.append({"KKTCUyruklu = FALSE", {}}); //In order to add AND Query, it is appended to whereConditions
+    }
+
+    if (filter.mtok) {
+        kontenjanConditions.append({"MTOK = TRUE", {}}); //In order to add OR Query, it is appended to kontenjanConditions
+    }
+    else {
+        whereConditions.append({"MTOK = FALSE", {}}); //In order to add AND Query, it is appended to whereConditions
+    }
+
+    if(!kontenjanConditions.isEmpty()) {
+        whereConditions.append(joinConditions(kontenjanConditions, "OR"));
+    }
+
+    if(!tuitionConditions.isEmpty()) {
+        whereConditions.append(joinConditions(tuitionConditions, "OR"));
+    }
+
+    ProgramQuery query;
+    query.sql = "SELECT * FROM ";
+    query.sql += tableName(filter.tercihTuru);
+
+    // LASTLY (FINALLY) process "WHERE" queries
+    if(!whereConditions.isEmpty()) {
+        const Condition where = joinConditions(whereConditions, "AND");
+        query.sql += " WHERE " + where.sql;
+        query.bindings = where.bindings;
+    }
+
+    // Column names cannot be bound, the sort column is part of the statement shape
+    if(filter.sortColumn == -1) {
+        query.sql += " ORDER BY ProgramKodu ASC";
+    }
+    else {
+        QString col = ProgramTable::dbColumnName(static_cast<ProgramTableColumns>(filter.sortColumn));
+        const QString key = SQLiteUtil::trOrderExprFor(col, useSortKeyColumns);
+        query.sql += " ORDER BY " + key;
+        if(filter.sortOrder == Qt::AscendingOrder)
+            query.sql += " ASC";
+        else
+            query.sql += " DESC";
+    }
+
+    return query;
+}
+
+QString ProgramQueryBuilder::tableName(TercihTuru tercihTuru) {
+    return tercihTuru == TercihTuru::EkTercih ? "EkTercihDetayli" : "YKS";
+}
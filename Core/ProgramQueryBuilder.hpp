@@ -0,0 +1,31 @@
+/*
+ProgramQueryBuilder class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QString>
+#include <QVariantList>
+#include "ProgramFilter.hpp"
+
+struct ProgramQuery {
+    // Canonical statement shape, every value is a '?' placeholder.
+    // Filters that differ only in their values share the same sql.
+    QString sql;
+    QVariantList bindings;
+};
+
+class ProgramQueryBuilder
+{
+public:
+    // useSortKeyColumns: the queried table has the Turkish sort key columns
+    // of the database optimizer, text columns are sorted by them
+    static ProgramQuery compile(const ProgramFilter &filter, bool useSortKeyColumns = false);
+    static QString tableName(TercihTuru tercihTuru);
+};
@@ -0,0 +1,158 @@
+/*
+ProgramQueryEngine class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramQueryEngine.hpp"
+#include <QDebug>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include "ProgramQueryBuilder.hpp"
+#include "ProgramStore.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+
+ProgramQueryEngine::ProgramQueryEngine(const ProgramStore *store, const QString &databasePath, const QString &connectionName)
+    : store(store)
+    , databasePath(databasePath)
+    , connectionName(connectionName)
+{
+}
+
+ProgramQueryEngine::~ProgramQueryEngine() {
+    // Prepared statements must go before their connection
+    preparedQueries.clear();
+    if (QSqlDatabase::contains(connectionName)) {
+        QSqlDatabase::database(connectionName, false).close();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+}
+
+bool ProgramQueryEngine::execute(const ProgramFilter &filter, ProgramQueryResult &result, const std::function<bool()> &isCancelled,
+                                 const std::function<void(const ProgramQueryResult &)> &firstPageReady) {
+    result.filter = filter;
+    result.trace.generation = result.generation;
+    // SQL has no condition for an empty selection, it would list every program
+    if (!filter.canMatch()) {
+        result.fromStore = store != nullptr && store->isLoaded();
+        result.trace.fromStore = result.fromStore;
+        return true;
+    }
+
+    if (store == nullptr || !store->isLoaded()) {
+        // Fallback: the tables could not be loaded into memory, query SQLite directly
+        result.fromStore = false;
+        if (!executeSql(filter, result, isCancelled, firstPageReady))
+            return false;
+        result.trace.rowCount = int(result.rowIds.size());
+        return true;
+    }
+
+    result.fromStore = true;
+    result.trace.fromStore = true;
+    const qint64 filterStartUs = QueryTrace::nowUs();
+    // The hit rate is reported through the trace record, not logged per lookup
+    if (results.find(filter, result.rowIds)) {
+        result.trace.cacheHit = true;
+    }
+    else {
+        result.trace.refined = hasLastResult && ProgramStore::isRefinement(filter, lastFilter);
+        if (result.trace.refined)
+            result.rowIds = store->refine(filter, lastFilter, lastRowIds);
+        else
+            result.rowIds = store->filter(filter);
+
+        if (isCancelled && isCancelled())
+            return false;
+        results.insert(filter, result.rowIds);
+    }
+    result.trace.phases[QueryTrace::Filter] = QueryTrace::spanSince(filterStartUs);
+    result.trace.rowCount = int(result.rowIds.size());
+    result.trace.cacheHits = results.hits();
+    result.trace.cacheLookups = results.hits() + results.misses();
+    hasLastResult = true;
+    lastFilter = filter;
+    lastRowIds = result.rowIds;
+    return true;
+}
+
+bool ProgramQueryEngine::executeSql(const ProgramFilter &filter, ProgramQueryResult &result, const std::function<bool()> &isCancelled,
+                                    const std::function<void(const ProgramQueryResult &)> &firstPageReady) {
+    if (!openDatabase())
+        return false;
+
+    const qint64 buildStartUs = QueryTrace::nowUs();
+    // Filters of the same shape reuse one prepared statement, only the values are bound again
+    const bool useSortKeyColumns = hasSortKeyColumns(ProgramQueryBuilder::tableName(filter.tercihTuru));
+    const ProgramQuery programQuery = ProgramQueryBuilder::compile(filter, useSortKeyColumns);
+    QSqlQuery *query = preparedQueries.acquire(QSqlDatabase::database(connectionName, false), programQuery.sql);
+    if (query == nullptr)
+        return false;
+
+    for (int i = 0; i < programQuery.bindings.size(); i++)
+        query->bindValue(i, programQuery.bindings.at(i));
+    result.trace.phases[QueryTrace::Build] = QueryTrace::spanSince(buildStartUs);
+
+    bool completed = false;
+    const qint64 execStartUs = QueryTrace::nowUs();
+    const bool executed = query->exec();
+    result.trace.phases[QueryTrace::Exec] = QueryTrace::spanSince(execStartUs);
+    if (executed) {
+        const qint64 fetchStartUs = QueryTrace::nowUs();
+        result.queryTable.tercihTuru = filter.tercihTuru;
+        if (firstPageReady) {
+            completed = result.queryTable.appendFromQuery(*query, isCancelled, FirstPageRows);
+            // A full first page may be followed by more rows, they are read after it is shown
+            if (completed && result.queryTable.rowCount == FirstPageRows) {
+                ProgramQueryResult firstPage = result;
+                firstPage.firstPage = true;
+                firstPage.rowIds.reserve(FirstPageRows);
+                for (int row = 0; row < FirstPageRows; row++)
+                    firstPage.rowIds.append(row);
+                firstPageReady(firstPage);
+                completed = result.queryTable.appendFromQuery(*query, isCancelled);
+            }
+        }
+        else {
+            completed = result.queryTable.appendFromQuery(*query, isCancelled);
+        }
+        result.trace.phases[QueryTrace::Fetch] = QueryTrace::spanSince(fetchStartUs);
+    }
+    else {
+        qDebug() << "Program sorgusu çalıştırılamadı:" << query->lastError().text();
+    }
+    // Release the statement so it can be executed again with new values
+    query->finish();
+
+    if (!completed)
+        return false;
+    result.rowIds.reserve(result.queryTable.rowCount);
+    for (int row = 0; row < result.queryTable.rowCount; row++)
+        result.rowIds.append(row);
+    return true;
+}
+
+bool ProgramQueryEngine::openDatabase() {
+    if (QSqlDatabase::contains(connectionName))
+        return QSqlDatabase::database(connectionName, false).isOpen();
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    if (!SQLiteUtil::openDatabase(db, databasePath)) {
+        qDebug() << "Sorgu bağlantısı açılamadı:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool ProgramQueryEngine::hasSortKeyColumns(const QString &table) {
+    // Databases that did not go through the optimizer lack the key columns
+    auto it = sortKeyTables.find(table);
+    if (it == sortKeyTables.end())
+        it = sortKeyTables.insert(table, SQLiteUtil::hasSortKeyColumns(QSqlDatabase::database(connectionName, false), table));
+    return it.value();
+}
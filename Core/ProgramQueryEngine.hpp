@@ -0,0 +1,78 @@
+/*
+ProgramQueryEngine class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include "PreparedQueryCache.hpp"
+#include "ProgramFilter.hpp"
+#include "ProgramTable.hpp"
+#include "QueryTrace.hpp"
+#include "ResultCache.hpp"
+
+class ProgramStore;
+
+struct ProgramQueryResult {
+    quint64 generation = 0;
+    // Only the first rows of an SQL result, the complete result follows with the same generation
+    bool firstPage = false;
+    ProgramFilter filter;
+    // true: rowIds index the program store table of filter.tercihTuru,
+    // false: rowIds index queryTable which was read from SQLite
+    bool fromStore = false;
+    QVector<int> rowIds;
+    ProgramTable queryTable;
+    // Phases timed by the engine, the GUI adds the model and paint phases
+    QueryTrace::Record trace;
+};
+
+// Answers a ProgramFilter without any user interface: from the in-memory
+// program store when it is loaded, otherwise by compiling the filter to SQL
+// and reading the rows through a connection of its own. Not thread-safe,
+// every thread that runs queries owns an engine.
+class ProgramQueryEngine
+{
+public:
+    // Rows read before an SQL result is handed out as its first page, more than one screen
+    static constexpr int FirstPageRows = 200;
+
+    ProgramQueryEngine(const ProgramStore *store, const QString &databasePath, const QString &connectionName);
+    ~ProgramQueryEngine();
+
+    // Fills every member of result except generation. Returns false when
+    // isCancelled() returned true or the SQL query failed. When SQLite is
+    // queried, firstPageReady gets the first FirstPageRows rows while the
+    // rest are still read, results from the program store come complete.
+    bool execute(const ProgramFilter &filter, ProgramQueryResult &result, const std::function<bool()> &isCancelled = nullptr,
+                 const std::function<void(const ProgramQueryResult &)> &firstPageReady = nullptr);
+
+    const ResultCache &resultCache() const { return results; }
+
+private:
+    bool executeSql(const ProgramFilter &filter, ProgramQueryResult &result, const std::function<bool()> &isCancelled,
+                    const std::function<void(const ProgramQueryResult &)> &firstPageReady);
+    bool openDatabase();
+    bool hasSortKeyColumns(const QString &table);
+
+    const ProgramStore *store;
+    QString databasePath;
+    QString connectionName;
+    PreparedQueryCache preparedQueries;
+    QHash<QString, bool> sortKeyTables;
+    ResultCache results;
+
+    // Last completed store result, narrowed instead of rescanned when the next filter refines it
+    bool hasLastResult = false;
+    ProgramFilter lastFilter;
+    QVector<int> lastRowIds;
+};
@@ -0,0 +1,83 @@
+/*
+ProgramQueryScheduler class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramQueryScheduler.hpp"
+
+ProgramQueryWorker::ProgramQueryWorker(const ProgramStore *store, const QString &databasePath, const std::atomic<quint64> *latestGeneration)
+    : latestGeneration(latestGeneration)
+    , engine(store, databasePath, QStringLiteral("ProgramQueryWorker_%1").arg(quintptr(this), 0, 16))
+{
+}
+
+void ProgramQueryWorker::run(quint64 generation, const ProgramFilter &filter) {
+    if (isStale(generation))
+        return;
+
+    ProgramQueryResult result;
+    result.generation = generation;
+    const bool completed = engine.execute(filter, result, [this, generation]() {
+        return isStale(generation);
+    }, [this, generation](const ProgramQueryResult &firstPage) {
+        if (!isStale(generation))
+            emit resultReady(firstPage);
+    });
+
+    if (completed && !isStale(generation))
+        emit resultReady(result);
+}
+
+bool ProgramQueryWorker::isStale(quint64 generation) const {
+    return generation != latestGeneration->load(std::memory_order_relaxed);
+}
+
+ProgramQueryScheduler::ProgramQueryScheduler(const ProgramStore *store, const QString &databasePath, QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<ProgramFilter>();
+    qRegisterMetaType<ProgramQueryResult>();
+
+    debounceTimer.setSingleShot(true);
+    connect(&debounceTimer, &QTimer::timeout, this, &ProgramQueryScheduler::dispatch);
+
+    auto *worker = new ProgramQueryWorker(store, databasePath, &generation);
+    worker->moveToThread(&workerThread);
+    connect(&workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    connect(this, &ProgramQueryScheduler::runRequested, worker, &ProgramQueryWorker::run);
+    connect(worker, &ProgramQueryWorker::resultReady, this, &ProgramQueryScheduler::onWorkerResultReady);
+    workerThread.start();
+}
+
+ProgramQueryScheduler::~ProgramQueryScheduler() {
+    cancel();
+    workerThread.quit();
+    workerThread.wait();
+}
+
+void ProgramQueryScheduler::schedule(const ProgramFilter &filter, int delayMs) {
+    pendingFilter = filter;
+    // A running query notices the new generation and stops early
+    generation++;
+    debounceTimer.start(delayMs);
+}
+
+void ProgramQueryScheduler::cancel() {
+    debounceTimer.stop();
+    generation++;
+}
+
+void ProgramQueryScheduler::dispatch() {
+    emit runRequested(generation.load(), pendingFilter);
+}
+
+void ProgramQueryScheduler::onWorkerResultReady(const ProgramQueryResult &result) {
+    if (result.generation != generation.load())
+        return;
+    emit resultReady(result);
+}
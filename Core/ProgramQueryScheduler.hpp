@@ -0,0 +1,74 @@
+/*
+ProgramQueryScheduler class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QMetaType>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+#include "ProgramFilter.hpp"
+#include "ProgramQueryEngine.hpp"
+
+class ProgramStore;
+
+Q_DECLARE_METATYPE(ProgramFilter)
+Q_DECLARE_METATYPE(ProgramQueryResult)
+
+// Runs the query engine on the worker thread
+class ProgramQueryWorker : public QObject {
+    Q_OBJECT
+public:
+    ProgramQueryWorker(const ProgramStore *store, const QString &databasePath, const std::atomic<quint64> *latestGeneration);
+
+public slots:
+    void run(quint64 generation, const ProgramFilter &filter);
+
+signals:
+    void resultReady(const ProgramQueryResult &result);
+
+private:
+    bool isStale(quint64 generation) const;
+
+    const std::atomic<quint64> *latestGeneration;
+    ProgramQueryEngine engine;
+};
+
+// Coalesces bursts of filter changes and runs only the latest one off the GUI thread.
+// Every schedule() call starts a new generation, results of older generations are dropped.
+// A result read from SQLite may arrive twice: its first page, then the complete result.
+class ProgramQueryScheduler : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int DefaultDelayMs = 100;
+
+    ProgramQueryScheduler(const ProgramStore *store, const QString &databasePath, QObject *parent = nullptr);
+    ~ProgramQueryScheduler();
+
+    void schedule(const ProgramFilter &filter, int delayMs = DefaultDelayMs);
+    // Drops the pending and the running query
+    void cancel();
+
+signals:
+    void resultReady(const ProgramQueryResult &result);
+    void runRequested(quint64 generation, const ProgramFilter &filter);
+
+private slots:
+    void dispatch();
+    void onWorkerResultReady(const ProgramQueryResult &result);
+
+private:
+    QThread workerThread;
+    QTimer debounceTimer;
+    ProgramFilter pendingFilter;
+    std::atomic<quint64> generation{0};
+};
@@ -0,0 +1,370 @@
+/*
+ProgramStore class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramStore.hpp"
+#include <QDebug>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <algorithm>
+#include <limits>
+#include "../Utils/StringUtil.hpp"
+
+bool ProgramStore::load(const QSqlDatabase &db) {
+    loaded = false;
+    if (!db.isOpen())
+        return false;
+
+    yksTable.tercihTuru = TercihTuru::NormalTercih;
+    ekTercihTable.tercihTuru = TercihTuru::EkTercih;
+    loaded = loadTable(db, "YKS", yksTable) && loadTable(db, "EkTercihDetayli", ekTercihTable);
+    if (loaded) {
+        buildSearchIndex(yksTable, yksSearch);
+        buildSearchIndex(ekTercihTable, ekTercihSearch);
+    }
+    return loaded;
+}
+
+void ProgramStore::buildSearchIndex(const ProgramTable &table, SearchIndex &search) {
+    // Same folding as the filter needles, so the indexes answer SQLite LIKE semantics
+    search.universiteAdi.build(table.foldedUniversiteAdi);
+    search.programAdi.build(table.foldedProgramAdi);
+
+    for (int group = 0; group < int(BasariSirasiColumns.size()); group++) {
+        const ProgramTableColumns column = BasariSirasiColumns[group];
+        if (table.isColumnAvailable(column))
+            search.basariSirasi[group].build(table.columns[(int) column].numbers);
+        else
+            search.basariSirasi[group].clear();
+    }
+}
+
+QVector<int> ProgramStore::selectedRankGroups(const ProgramFilter &filter) {
+    // Same kontenjan türleri as the score range
+    QVector<int> groups;
+    if (filter.includesGenelScores()) groups.append(0);
+    if (filter.okulBirincisi)         groups.append(1);
+    if (filter.sehitGaziYakini)       groups.append(2);
+    if (filter.depremzede)            groups.append(3);
+    if (filter.kadin34)               groups.append(4);
+    return groups;
+}
+
+bool ProgramStore::loadTable(const QSqlDatabase &db, const QString &tableName, ProgramTable &table) {
+    table.clear();
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT * FROM " + tableName + " ORDER BY ProgramKodu ASC")) {
+        qDebug() << tableName << "tablosu belleğe yüklenemedi:" << query.lastError().text();
+        return false;
+    }
+    table.appendFromQuery(query);
+    table.buildSortRanks();
+    return true;
+}
+
+const ProgramTable &ProgramStore::table(TercihTuru tercihTuru) const {
+    return tercihTuru == TercihTuru::EkTercih ? ekTercihTable : yksTable;
+}
+
+bool ProgramStore::hasBasariSirasi(TercihTuru tercihTuru) const {
+    for (const RankIndex &index : searchIndex(tercihTuru).basariSirasi) {
+        if (index.size() > 0)
+            return true;
+    }
+    return false;
+}
+
+const ProgramStore::SearchIndex &ProgramStore::searchIndex(TercihTuru tercihTuru) const {
+    return tercihTuru == TercihTuru::EkTercih ? ekTercihSearch : yksSearch;
+}
+
+QVector<int> ProgramStore::filter(const ProgramFilter &filter) const {
+    if (!loaded || !filter.canMatch())
+        return QVector<int>();
+
+    const ProgramTable &t = table(filter.tercihTuru);
+    QVector<int> rowIds = filterRows(t, filter, t.rowCount, [](int j) { return j; }, true);
+    sort(t, rowIds, filter.sortColumn, filter.sortOrder);
+    return rowIds;
+}
+
+QVector<int> ProgramStore::refine(const ProgramFilter &filter, const ProgramFilter &previous, const QVector<int> &previousRowIds) const {
+    if (!isRefinement(filter, previous))
+        return this->filter(filter);
+    if (!loaded || !filter.canMatch())
+        return QVector<int>();
+
+    const ProgramTable &t = table(filter.tercihTuru);
+    const int *ids = previousRowIds.constData();
+    QVector<int> rowIds = filterRows(t, filter, int(previousRowIds.size()), [ids](int j) { return ids[j]; }, false);
+
+    // Dropping rows keeps the previous order, it only has to change with the sort settings
+    if (filter.sortColumn != previous.sortColumn || filter.sortOrder != previous.sortOrder) {
+        if (filter.sortColumn < 0)
+            std::sort(rowIds.begin(), rowIds.end());
+        else
+            sort(t, rowIds, filter.sortColumn, filter.sortOrder);
+    }
+    return rowIds;
+}
+
+bool ProgramStore::isRefinement(const ProgramFilter &filter, const ProgramFilter &previous) {
+    if (filter.tercihTuru != previous.tercihTuru)
+        return false;
+
+    // Every text containing the longer needle contains its substring
+    const QString previousUniversity = universityNeedle(previous);
+    const QString previousDepartment = departmentNeedle(previous);
+    if (!previousUniversity.isEmpty() && !universityNeedle(filter).contains(previousUniversity))
+        return false;
+    if (!previousDepartment.isEmpty() && !departmentNeedle(filter).contains(previousDepartment))
+        return false;
+
+    if ((previous.ulke != Ulke::Tumu && filter.ulke != previous.ulke) ||
+        (previous.lisansTuru != LisansTuru::Tumu && filter.lisansTuru != previous.lisansTuru) ||
+        (previous.universiteTuru != UniversiteTuru::Tumu && filter.universiteTuru != previous.universiteTuru) ||
+        (previous.puanTuru != PuanTuru::Tumu && filter.puanTuru != previous.puanTuru))
+        return false;
+
+    // Kontenjan and tuition boxes are OR groups, a box may only be unchecked.
+    // Unchecking KKTC uyruklu or M.T.O.K also excludes their programs, which narrows further.
+    const auto subset = [](bool now, bool before) { return !now || before; };
+    if (!subset(filter.genel, previous.genel) ||
+        !subset(filter.okulBirincisi, previous.okulBirincisi) ||
+        !subset(filter.sehitGaziYakini, previous.sehitGaziYakini) ||
+        !subset(filter.depremzede, previous.depremzede) ||
+        !subset(filter.kadin34, previous.kadin34) ||
+        !subset(filter.kktcUyruklu, previous.kktcUyruklu) ||
+        !subset(filter.mtok, previous.mtok) ||
+        !subset(filter.ucretsiz, previous.ucretsiz) ||
+        !subset(filter.indirimli, previous.indirimli) ||
+        !subset(filter.ucretli, previous.ucretli))
+        return false;
+
+    // The score columns only lose members above, so the range may only shrink
+    if (previous.hasScoreRange()) {
+        if (!filter.hasScoreRange())
+            return false;
+        const double infinity = std::numeric_limits<double>::infinity();
+        const double lower = filter.hasMinimumScore() ? filter.enKucukPuan : -infinity;
+        const double upper = filter.hasMaximumScore() ? filter.enBuyukPuan : infinity;
+        const double previousLower = previous.hasMinimumScore() ? previous.enKucukPuan : -infinity;
+        const double previousUpper = previous.hasMaximumScore() ? previous.enBuyukPuan : infinity;
+        if (lower < previousLower || upper > previousUpper)
+            return false;
+    }
+
+    // Same for the başarı sırası range, an open end counts as unbounded
+    if (previous.hasRankRange()) {
+        if (!filter.hasRankRange())
+            return false;
+        const int lower = filter.hasMinimumRank() ? filter.enKucukBasariSirasi : 0;
+        const int upper = filter.hasMaximumRank() ? filter.enBuyukBasariSirasi : std::numeric_limits<int>::max();
+        const int previousLower = previous.hasMinimumRank() ? previous.enKucukBasariSirasi : 0;
+        const int previousUpper = previous.hasMaximumRank() ? previous.enBuyukBasariSirasi : std::numeric_limits<int>::max();
+        if (lower < previousLower || upper > previousUpper)
+            return false;
+    }
+    return true;
+}
+
+QString ProgramStore::universityNeedle(const ProgramFilter &filter) {
+    return filter.universityName.trimmed().isEmpty()
+            ? QString()
+            : ProgramTable::foldForLike(StringUtil::toTurkishUpperCase(filter.universityName));
+}
+
+QString ProgramStore::departmentNeedle(const ProgramFilter &filter) {
+    return filter.department.trimmed().isEmpty()
+            ? QString()
+            : ProgramTable::foldForLike(StringUtil::toTurkishTitleCase(filter.department));
+}
+
+template <typename RowAt>
+QVector<int> ProgramStore::filterRows(const ProgramTable &t, const ProgramFilter &filter, int n, RowAt rowAt, bool useSearchIndex) const {
+    // k[j] belongs to row rowAt(j): every row of the table, or the rows of a previous result
+    QVector<quint8> keep(n, 1);
+    quint8 *k = keep.data();
+
+    // Each pass is a branch-free loop over one column, so the compiler can vectorize it
+    const auto applyMask = [k, n, &rowAt](const QVector<quint8> &column, quint8 mask) {
+        const quint8 *values = column.constData();
+        for (int j = 0; j < n; j++)
+            k[j] &= quint8((values[rowAt(j)] & mask) != 0);
+    };
+
+    switch (filter.ulke) {
+    case Ulke::Turkiye:  applyMask(t.ulke, ProgramTable::UlkeTurkiye); break;
+    case Ulke::KKTC:     applyMask(t.ulke, ProgramTable::UlkeKKTC); break;
+    case Ulke::Yurtdisi: applyMask(t.ulke, ProgramTable::UlkeYurtdisi); break;
+    default: break;
+    }
+
+    if (filter.lisansTuru == LisansTuru::Lisans)
+        applyMask(t.lisans, ProgramTable::BoolTrue);
+    else if (filter.lisansTuru == LisansTuru::Onlisans)
+        applyMask(t.lisans, ProgramTable::BoolFalse);
+
+    if (filter.universiteTuru == UniversiteTuru::Devlet)
+        applyMask(t.devletUniversitesi, ProgramTable::BoolTrue);
+    else if (filter.universiteTuru == UniversiteTuru::Vakif)
+        applyMask(t.devletUniversitesi, ProgramTable::BoolFalse);
+
+    switch (filter.puanTuru) {
+    case PuanTuru::SAY: applyMask(t.puanTuru, ProgramTable::PuanSAY); break;
+    case PuanTuru::EA:  applyMask(t.puanTuru, ProgramTable::PuanEA); break;
+    case PuanTuru::SOZ: applyMask(t.puanTuru, ProgramTable::PuanSOZ); break;
+    case PuanTuru::TYT: applyMask(t.puanTuru, ProgramTable::PuanTYT); break;
+    case PuanTuru::DIL: applyMask(t.puanTuru, ProgramTable::PuanDIL); break;
+    default: break;
+    }
+
+    quint8 ucretMask = 0;
+    if (filter.ucretsiz)  ucretMask |= ProgramTable::Ucretsiz;
+    if (filter.indirimli) ucretMask |= ProgramTable::Indirimli;
+    if (filter.ucretli)   ucretMask |= ProgramTable::Ucretli;
+    applyMask(t.ucretDurumu, ucretMask);
+
+    if (!filter.kktcUyruklu)
+        applyMask(t.kktcUyruklu, ProgramTable::BoolFalse);
+    if (!filter.mtok)
+        applyMask(t.mtok, ProgramTable::BoolFalse);
+
+    // Kontenjan türleri are OR-ed, KKTC uyruklu and M.T.O.K join the same group
+    quint8 kontenjanMask = 0;
+    if (filter.genel)           kontenjanMask |= ProgramTable::KontenjanGenel;
+    if (filter.okulBirincisi)   kontenjanMask |= ProgramTable::KontenjanOkulBirincisi;
+    if (filter.sehitGaziYakini) kontenjanMask |= ProgramTable::KontenjanSehitGazi;
+    if (filter.depremzede)      kontenjanMask |= ProgramTable::KontenjanDepremzede;
+    if (filter.kadin34)         kontenjanMask |= ProgramTable::KontenjanKadin34;
+    const quint8 kktcMask = filter.kktcUyruklu ? ProgramTable::BoolTrue : 0;
+    const quint8 mtokMask = filter.mtok ? ProgramTable::BoolTrue : 0;
+    {
+        const quint8 *kontenjan = t.kontenjan.constData();
+        const quint8 *kktc = t.kktcUyruklu.constData();
+        const quint8 *mtok = t.mtok.constData();
+        for (int j = 0; j < n; j++) {
+            const int i = rowAt(j);
+            k[j] &= quint8(((kontenjan[i] & kontenjanMask) | (kktc[i] & kktcMask) | (mtok[i] & mtokMask)) != 0);
+        }
+    }
+
+    if (filter.hasScoreRange()) {
+        QVector<ProgramTableColumns> scoreColumns;
+        if (filter.includesGenelScores()) scoreColumns.append(ProgramTableColumns::GenelEnKucukPuan);
+        if (filter.okulBirincisi)         scoreColumns.append(ProgramTableColumns::OkulBirincisiEnKucukPuan);
+        if (filter.sehitGaziYakini)       scoreColumns.append(ProgramTableColumns::SehitGaziYakiniEnKucukPuan);
+        if (filter.depremzede)            scoreColumns.append(ProgramTableColumns::DepremzedeEnKucukPuan);
+        if (filter.kadin34)               scoreColumns.append(ProgramTableColumns::Kadin34PlusEnKucukPuan);
+
+        // NULL scores are NaN, every comparison with them is false as in SQL
+        const double lower = filter.hasMinimumScore() ? filter.enKucukPuan : -std::numeric_limits<double>::infinity();
+        const double upper = filter.hasMaximumScore() ? filter.enBuyukPuan : std::numeric_limits<double>::infinity();
+
+        QVector<quint8> inRange(n, 0);
+        quint8 *r = inRange.data();
+        for (ProgramTableColumns column : scoreColumns) {
+            const double *scores = t.columns[(int) column].numbers.constData();
+            for (int j = 0; j < n; j++) {
+                const double score = scores[rowAt(j)];
+                r[j] |= quint8(score > lower && score < upper);
+            }
+        }
+        for (int j = 0; j < n; j++)
+            k[j] &= r[j];
+    }
+
+    if (filter.hasRankRange()) {
+        const double lower = filter.hasMinimumRank() ? filter.enKucukBasariSirasi : -std::numeric_limits<double>::infinity();
+        const double upper = filter.hasMaximumRank() ? filter.enBuyukBasariSirasi : std::numeric_limits<double>::infinity();
+        const QVector<int> groups = selectedRankGroups(filter);
+
+        if (useSearchIndex) {
+            // Binary search per kontenjan türü, the rows in range are one slice of its sorted ranks
+            const SearchIndex &search = searchIndex(filter.tercihTuru);
+            QVector<quint8> inRange(t.rowCount, 0);
+            quint8 *r = inRange.data();
+            for (int group : groups) {
+                const RankIndex::Slice slice = search.basariSirasi[group].find(lower, upper);
+                for (const int *row = slice.first; row != slice.last; ++row)
+                    r[*row] = 1;
+            }
+            for (int j = 0; j < n; j++)
+                k[j] &= r[rowAt(j)];
+        }
+        else {
+            // Over a previous result the few rows are compared directly, NaN never matches
+            QVector<quint8> inRange(n, 0);
+            quint8 *r = inRange.data();
+            for (int group : groups) {
+                const double *ranks = t.columns[(int) BasariSirasiColumns[group]].numbers.constData();
+                for (int j = 0; j < n; j++) {
+                    const double rank = ranks[rowAt(j)];
+                    r[j] |= quint8(rank >= lower && rank <= upper);
+                }
+            }
+            for (int j = 0; j < n; j++)
+                k[j] &= r[j];
+        }
+    }
+
+    // Text searches run last. Over the whole table they are answered by the
+    // trigram indexes, over a previous result the few candidates are checked directly.
+    const QString universityNeedle = ProgramStore::universityNeedle(filter);
+    const QString departmentNeedle = ProgramStore::departmentNeedle(filter);
+    if (useSearchIndex) {
+        const SearchIndex &search = searchIndex(filter.tercihTuru);
+        const int rowCount = t.rowCount;
+        const auto applyMatches = [k, n, rowCount, &rowAt](const QVector<int> &matches) {
+            QVector<quint8> matched(rowCount, 0);
+            for (int id : matches)
+                matched[id] = 1;
+            const quint8 *m = matched.constData();
+            for (int j = 0; j < n; j++)
+                k[j] &= m[rowAt(j)];
+        };
+        if (!universityNeedle.isEmpty())
+            applyMatches(search.universiteAdi.find(universityNeedle));
+        if (!departmentNeedle.isEmpty())
+            applyMatches(search.programAdi.find(departmentNeedle));
+    }
+    else {
+        for (int j = 0; j < n; j++) {
+            if (!k[j])
+                continue;
+            const int i = rowAt(j);
+            if (!universityNeedle.isEmpty() && !t.foldedUniversiteAdi.at(i).contains(universityNeedle))
+                k[j] = 0;
+            else if (!departmentNeedle.isEmpty() && !t.foldedProgramAdi.at(i).contains(departmentNeedle))
+                k[j] = 0;
+        }
+    }
+
+    int matchCount = 0;
+    for (int j = 0; j < n; j++)
+        matchCount += k[j];
+
+    QVector<int> rowIds;
+    rowIds.reserve(matchCount);
+    for (int j = 0; j < n; j++) {
+        if (k[j])
+            rowIds.append(rowAt(j));
+    }
+    return rowIds;
+}
+
+void ProgramStore::sort(const ProgramTable &table, QVector<int> &rowIds, int column, Qt::SortOrder order) const {
+    // Tables are loaded in ProgramKodu order, the default order needs no work
+    if (column < 0 || column >= ProgramTableColumnCount)
+        return;
+
+    table.sortRows(rowIds, column, order);
+}
@@ -0,0 +1,77 @@
+/*
+ProgramStore class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QSqlDatabase>
+#include <QVector>
+#include <array>
+#include "ProgramFilter.hpp"
+#include "ProgramTable.hpp"
+#include "RankIndex.hpp"
+#include "TrigramIndex.hpp"
+
+// YKS and EkTercihDetayli tables kept in memory, so filter changes are
+// answered by passes over the column arrays instead of SQL queries.
+class ProgramStore
+{
+public:
+    bool load(const QSqlDatabase &db);
+    bool isLoaded() const { return loaded; }
+
+    const ProgramTable &table(TercihTuru tercihTuru) const;
+    // False when the table has no başarı sırası values, e.g. ek tercih or an older database
+    bool hasBasariSirasi(TercihTuru tercihTuru) const;
+
+    // Returns the matching row indexes of table(filter.tercihTuru) in sorted order
+    QVector<int> filter(const ProgramFilter &filter) const;
+    // Same result as filter(), evaluated only over previousRowIds when filter
+    // can only drop rows from the result of previous (see isRefinement())
+    QVector<int> refine(const ProgramFilter &filter, const ProgramFilter &previous, const QVector<int> &previousRowIds) const;
+    // True when every row matching filter also matches previous, sorting aside
+    static bool isRefinement(const ProgramFilter &filter, const ProgramFilter &previous);
+    void sort(const ProgramTable &table, QVector<int> &rowIds, int column, Qt::SortOrder order) const;
+
+    // Needles folded like ProgramTable::foldedUniversiteAdi / foldedProgramAdi, empty when not searched
+    static QString universityNeedle(const ProgramFilter &filter);
+    static QString departmentNeedle(const ProgramFilter &filter);
+
+private:
+    // Başarı sırası columns of the kontenjan türleri, in ProgramTable::KontenjanBits order
+    static constexpr std::array<ProgramTableColumns, 5> BasariSirasiColumns = {
+        ProgramTableColumns::GenelBasariSirasi,
+        ProgramTableColumns::OkulBirincisiBasariSirasi,
+        ProgramTableColumns::SehitGaziYakiniBasariSirasi,
+        ProgramTableColumns::DepremzedeBasariSirasi,
+        ProgramTableColumns::Kadin34PlusBasariSirasi
+    };
+
+    struct SearchIndex {
+        TrigramIndex universiteAdi;
+        TrigramIndex programAdi;
+        // One sorted rank array per kontenjan türü
+        std::array<RankIndex, BasariSirasiColumns.size()> basariSirasi;
+    };
+
+    void buildSearchIndex(const ProgramTable &table, SearchIndex &search);
+    // Başarı sırası columns the filter compares, one per selected kontenjan türü
+    static QVector<int> selectedRankGroups(const ProgramFilter &filter);
+
+    bool loadTable(const QSqlDatabase &db, const QString &tableName, ProgramTable &table);
+    const SearchIndex &searchIndex(TercihTuru tercihTuru) const;
+    template <typename RowAt>
+    QVector<int> filterRows(const ProgramTable &t, const ProgramFilter &filter, int n, RowAt rowAt, bool useSearchIndex) const;
+
+    ProgramTable yksTable;
+    ProgramTable ekTercihTable;
+    SearchIndex yksSearch;
+    SearchIndex ekTercihSearch;
+    bool loaded = false;
+};
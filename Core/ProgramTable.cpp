@@ -0,0 +1,330 @@
+/*
+ProgramTable struct definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramTable.hpp"
+#include <QCollator>
+#include <QLocale>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+quint8 boolBits(const QVariant &value) {
+    if (value.isNull())
+        return 0;
+    return value.toInt() != 0 ? ProgramTable::BoolTrue : ProgramTable::BoolFalse;
+}
+
+quint8 ulkeBits(const QVariant &value) {
+    if (value.isNull())
+        return 0;
+    const int code = value.toInt();
+    if (code == 90)
+        return ProgramTable::UlkeTurkiye;
+    if (code == 357)
+        return ProgramTable::UlkeKKTC;
+    return ProgramTable::UlkeYurtdisi;
+}
+
+quint8 puanTuruBits(const QVariant &value) {
+    const QString puanTuru = value.toString();
+    if (puanTuru == QStringLiteral("SAY")) return ProgramTable::PuanSAY;
+    if (puanTuru == QStringLiteral("EA"))  return ProgramTable::PuanEA;
+    if (puanTuru == QStringLiteral("SÖZ")) return ProgramTable::PuanSOZ;
+    if (puanTuru == QStringLiteral("TYT")) return ProgramTable::PuanTYT;
+    if (puanTuru == QStringLiteral("DİL")) return ProgramTable::PuanDIL;
+    return 0;
+}
+
+quint8 ucretBits(const QVariant &value) {
+    if (value.isNull())
+        return 0;
+    switch (value.toInt()) {
+    case 0:   return ProgramTable::Ucretsiz;
+    case 50:  return ProgramTable::Indirimli;
+    case 100: return ProgramTable::Ucretli;
+    default:  return 0;
+    }
+}
+
+QString numberToText(double value) {
+    if (value == std::floor(value) && std::fabs(value) < 1e15)
+        return QString::number(qint64(value));
+    return QString::number(value, 'g', QLocale::FloatingPointShortest);
+}
+
+quint64 cellKey(int row, int column) {
+    return (quint64(row) << 8) | quint64(column);
+}
+
+}
+
+void ProgramTable::clear() {
+    for (Column &c : columns) {
+        // clear() keeps the capacity, so the next load does not reallocate
+        c.texts.clear();
+        c.numbers.clear();
+    }
+    nonNumericCells.clear();
+    ulke.clear();
+    lisans.clear();
+    devletUniversitesi.clear();
+    puanTuru.clear();
+    ucretDurumu.clear();
+    kktcUyruklu.clear();
+    mtok.clear();
+    kontenjan.clear();
+    foldedUniversiteAdi.clear();
+    foldedProgramAdi.clear();
+    for (QVector<int> &ranks : sortRanks)
+        ranks.clear();
+    rowCount = 0;
+}
+
+bool ProgramTable::appendFromQuery(QSqlQuery &query, const std::function<bool()> &isCancelled, int maxRows) {
+    // Resolve the record positions once instead of looking up names per row
+    const QSqlRecord record = query.record();
+    std::array<int, ProgramTableColumnCount> fieldIndexes;
+    for (int col = 0; col < ProgramTableColumnCount; col++) {
+        const QString name = dbColumnName(static_cast<ProgramTableColumns>(col));
+        fieldIndexes[col] = name.isEmpty() ? -1 : record.indexOf(name);
+    }
+
+    const int ulkeField = record.indexOf("UlkeKodu");
+    const int lisansField = record.indexOf("Lisans");
+    const int devletField = record.indexOf("DevletUniversitesi");
+    const int ucretField = record.indexOf("UcretDurumu");
+    const int kktcField = record.indexOf("KKTCUyruklu");
+    const int mtokField = record.indexOf("MTOK");
+    const std::array<int, 5> kontenjanFields = {
+        record.indexOf("GenelKontenjan"),
+        record.indexOf("OkulBirincisiKontenjan"),
+        record.indexOf("SehitGaziKontenjan"),
+        record.indexOf("DepremzedeKontenjan"),
+        record.indexOf("Kadin34Kontenjan")
+    };
+
+    const auto fieldValue = [&query](int field) {
+        return field < 0 ? QVariant() : query.value(field);
+    };
+
+    const double empty = std::numeric_limits<double>::quiet_NaN();
+    const int lastRow = maxRows < 0 ? std::numeric_limits<int>::max() : rowCount + maxRows;
+    while (rowCount < lastRow && query.next()) {
+        if (isCancelled && (rowCount & 0xFF) == 0 && isCancelled())
+            return false;
+
+        for (int col = 0; col < ProgramTableColumnCount; col++) {
+            Column &c = columns[col];
+            const int field = fieldIndexes[col];
+
+            if (isTextColumn(static_cast<ProgramTableColumns>(col))) {
+                c.texts.append(field < 0 ? QString() : query.value(field).toString());
+                continue;
+            }
+
+            if (field < 0) {
+                c.numbers.append(empty);
+                continue;
+            }
+
+            const QVariant value = query.value(field);
+            bool ok = false;
+            const double number = value.isNull() ? empty : value.toDouble(&ok);
+            if (!ok && !value.isNull()) {
+                const QString text = value.toString();
+                if (!text.isEmpty())
+                    nonNumericCells.insert(cellKey(rowCount, col), text);
+            }
+            c.numbers.append(ok ? number : empty);
+        }
+
+        ulke.append(ulkeBits(fieldValue(ulkeField)));
+        lisans.append(boolBits(fieldValue(lisansField)));
+        devletUniversitesi.append(boolBits(fieldValue(devletField)));
+        puanTuru.append(puanTuruBits(columns[(int) ProgramTableColumns::PuanTuru].texts.last()));
+        ucretDurumu.append(ucretBits(fieldValue(ucretField)));
+        kktcUyruklu.append(boolBits(fieldValue(kktcField)));
+        mtok.append(boolBits(fieldValue(mtokField)));
+
+        quint8 kontenjanMask = 0;
+        for (int i = 0; i < (int) kontenjanFields.size(); i++) {
+            if (!fieldValue(kontenjanFields[i]).isNull())
+                kontenjanMask |= quint8(1 << i);
+        }
+        kontenjan.append(kontenjanMask);
+
+        foldedUniversiteAdi.append(foldForLike(columns[(int) ProgramTableColumns::Universite].texts.last()));
+        foldedProgramAdi.append(foldForLike(columns[(int) ProgramTableColumns::Program].texts.last()));
+
+        rowCount++;
+    }
+    return true;
+}
+
+QVariant ProgramTable::displayData(int row, int column) const {
+    const auto programTableColumn = static_cast<ProgramTableColumns>(column);
+    if (!isColumnAvailable(programTableColumn))
+        return QVariant();
+
+    const Column &c = columns[column];
+    if (isTextColumn(programTableColumn))
+        return c.texts.at(row);
+
+    const double value = c.numbers.at(row);
+    if (std::isnan(value))
+        return nonNumericCells.value(cellKey(row, column));
+    return numberToText(value);
+}
+
+double ProgramTable::number(int row, ProgramTableColumns column) const {
+    return columns[(int) column].numbers.at(row);
+}
+
+const QString &ProgramTable::text(int row, ProgramTableColumns column) const {
+    return columns[(int) column].texts.at(row);
+}
+
+bool ProgramTable::isColumnAvailable(ProgramTableColumns column) const {
+    //Ek kontenjanda yok
+    if (tercihTuru != TercihTuru::EkTercih)
+        return true;
+
+    switch (column) {
+    case ProgramTableColumns::GenelYerlesen:
+    case ProgramTableColumns::OkulBirincisiKontenjan:
+    case ProgramTableColumns::OkulBirincisiYerlesen:
+    case ProgramTableColumns::OkulBirincisiEnKucukPuan:
+    case ProgramTableColumns::SehitGaziYakiniYerlesen:
+    case ProgramTableColumns::DepremzedeYerlesen:
+    case ProgramTableColumns::Kadin34PlusYerlesen:
+    // Ek yerleştirme sonuçları başarı sırası içermez
+    case ProgramTableColumns::GenelBasariSirasi:
+    case ProgramTableColumns::OkulBirincisiBasariSirasi:
+    case ProgramTableColumns::SehitGaziYakiniBasariSirasi:
+    case ProgramTableColumns::DepremzedeBasariSirasi:
+    case ProgramTableColumns::Kadin34PlusBasariSirasi:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void ProgramTable::buildSortRanks() {
+    for (int col = 0; col < ProgramTableColumnCount; col++)
+        sortRanks[col] = computeSortRanks(col);
+}
+
+QVector<int> ProgramTable::computeSortRanks(int column) const {
+    QVector<int> order(rowCount);
+    for (int row = 0; row < rowCount; row++)
+        order[row] = row;
+
+    if (isTextColumn(static_cast<ProgramTableColumns>(column))) {
+        // Sort keys are built once per row instead of collating on every comparison
+        QCollator collator(QLocale(QLocale::Turkish, QLocale::Turkey));
+        const auto &texts = columns[column].texts;
+        std::vector<QCollatorSortKey> keys;
+        keys.reserve(rowCount);
+        for (int row = 0; row < rowCount; row++)
+            keys.push_back(collator.sortKey(texts.at(row)));
+        std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+            return keys[a].compare(keys[b]) < 0;
+        });
+    }
+    else {
+        // NULL values come first in ascending order, as SQLite sorts them
+        const auto &numbers = columns[column].numbers;
+        std::stable_sort(order.begin(), order.end(), [&numbers](int a, int b) {
+            const double x = numbers.at(a);
+            const double y = numbers.at(b);
+            if (std::isnan(x))
+                return !std::isnan(y);
+            return !std::isnan(y) && x < y;
+        });
+    }
+
+    QVector<int> ranks(rowCount);
+    for (int position = 0; position < rowCount; position++)
+        ranks[order.at(position)] = position;
+    return ranks;
+}
+
+void ProgramTable::sortRows(QVector<int> &rowIds, int column, Qt::SortOrder order) const {
+    if (column < 0 || column >= ProgramTableColumnCount) {
+        column = (int) ProgramTableColumns::ProgramKodu;
+        order = Qt::AscendingOrder;
+    }
+
+    QVector<int> computedRanks;
+    const QVector<int> *ranks = &sortRanks[column];
+    if (ranks->size() != rowCount) {
+        computedRanks = computeSortRanks(column);
+        ranks = &computedRanks;
+    }
+
+    // Ranks are unique, the descending order is exactly the reverse of the ascending one
+    std::sort(rowIds.begin(), rowIds.end(), [ranks](int a, int b) {
+        return ranks->at(a) < ranks->at(b);
+    });
+    if (order == Qt::DescendingOrder)
+        std::reverse(rowIds.begin(), rowIds.end());
+}
+
+QString ProgramTable::dbColumnName(ProgramTableColumns column) {
+    switch (column) {
+    case ProgramTableColumns::ProgramKodu:              return "ProgramKodu";
+    case ProgramTableColumns::Universite:               return "UniversiteAdi";
+    case ProgramTableColumns::Kampus:                   return "FakulteYuksekokulAdi";
+    case ProgramTableColumns::Program:                  return "ProgramAdi";
+    case ProgramTableColumns::PuanTuru:                 return "PuanTuru";
+    case ProgramTableColumns::GenelKontenjan:           return "GenelKontenjan";
+    case ProgramTableColumns::GenelYerlesen:            return "GenelYerlesen";
+    case ProgramTableColumns::GenelBasariSirasi:        return "GenelBasariSirasi";
+    case ProgramTableColumns::GenelEnKucukPuan:         return "GenelEnKucukPuan";
+    case ProgramTableColumns::OkulBirincisiKontenjan:   return "OkulBirincisiKontenjan";
+    case ProgramTableColumns::OkulBirincisiYerlesen:    return "OkulBirincisiYerlesen";
+    case ProgramTableColumns::OkulBirincisiBasariSirasi:return "OkulBirincisiBasariSirasi";
+    case ProgramTableColumns::OkulBirincisiEnKucukPuan: return "OkulBirincisiEnKucukPuan";
+    case ProgramTableColumns::SehitGaziYakiniKontenjan: return "SehitGaziKontenjan";
+    case ProgramTableColumns::SehitGaziYakiniYerlesen:  return "SehitGaziYerlesen";
+    case ProgramTableColumns::SehitGaziYakiniBasariSirasi:return "SehitGaziBasariSirasi";
+    case ProgramTableColumns::SehitGaziYakiniEnKucukPuan:return "SehitGaziEnKucukPuan";
+    case ProgramTableColumns::DepremzedeKontenjan:      return "DepremzedeKontenjan";
+    case ProgramTableColumns::DepremzedeYerlesen:       return "DepremzedeYerlesen";
+    case ProgramTableColumns::DepremzedeBasariSirasi:   return "DepremzedeBasariSirasi";
+    case ProgramTableColumns::DepremzedeEnKucukPuan:    return "DepremzedeEnKucukPuan";
+    case ProgramTableColumns::Kadin34PlusKontenjan:     return "Kadin34Kontenjan";
+    case ProgramTableColumns::Kadin34PlusYerlesen:      return "Kadin34Yerlesen";
+    case ProgramTableColumns::Kadin34PlusBasariSirasi:  return "Kadin34BasariSirasi";
+    case ProgramTableColumns::Kadin34PlusEnKucukPuan:   return "Kadin34EnKucukPuan";
+    default: return QString();
+    }
+}
+
+bool ProgramTable::isTextColumn(ProgramTableColumns column) {
+    return column == ProgramTableColumns::Universite ||
+           column == ProgramTableColumns::Kampus ||
+           column == ProgramTableColumns::Program ||
+           column == ProgramTableColumns::PuanTuru;
+}
+
+QString ProgramTable::foldForLike(const QString &text) {
+    QString folded = text;
+    for (QChar &c : folded) {
+        if (c >= QLatin1Char('A') && c <= QLatin1Char('Z'))
+            c = QChar(c.unicode() + ('a' - 'A'));
+    }
+    return folded;
+}
@@ -0,0 +1,91 @@
+/*
+ProgramTable struct declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <array>
+#include <functional>
+#include "../EnumDefinitions.hpp"
+
+class QSqlQuery;
+
+// Struct-of-arrays copy of a YKS / EkTercihDetayli result set.
+// Display columns are keyed by ProgramTableColumns, the filter columns
+// hold one bit code per row so a filter pass is a mask test per element.
+// A bit code of 0 stands for NULL in the database and never matches.
+struct ProgramTable {
+    enum UlkeBits : quint8 { UlkeTurkiye = 1, UlkeKKTC = 2, UlkeYurtdisi = 4 };
+    enum BoolBits : quint8 { BoolTrue = 1, BoolFalse = 2 };
+    enum PuanTuruBits : quint8 { PuanSAY = 1, PuanEA = 2, PuanSOZ = 4, PuanTYT = 8, PuanDIL = 16 };
+    enum UcretBits : quint8 { Ucretsiz = 1, Indirimli = 2, Ucretli = 4 };
+    enum KontenjanBits : quint8 {
+        KontenjanGenel = 1,
+        KontenjanOkulBirincisi = 2,
+        KontenjanSehitGazi = 4,
+        KontenjanDepremzede = 8,
+        KontenjanKadin34 = 16
+    };
+
+    // Metin sütunları texts, sayısal sütunlar numbers dizisini kullanır.
+    // Boş (NULL) sayısal hücreler NaN olarak saklanır.
+    struct Column {
+        QVector<QString> texts;
+        QVector<double> numbers;
+    };
+
+    TercihTuru tercihTuru = TercihTuru::NormalTercih;
+    int rowCount = 0;
+
+    std::array<Column, ProgramTableColumnCount> columns;
+    // Sayısal sütunlarda sayıya çevrilemeyen nadir değerler (ör. "Dolmadı")
+    QHash<quint64, QString> nonNumericCells;
+
+    // Filter columns
+    QVector<quint8> ulke;
+    QVector<quint8> lisans;
+    QVector<quint8> devletUniversitesi;
+    QVector<quint8> puanTuru;
+    QVector<quint8> ucretDurumu;
+    QVector<quint8> kktcUyruklu;
+    QVector<quint8> mtok;
+    QVector<quint8> kontenjan;
+
+    // Names folded the way SQLite LIKE compares them (ASCII case-insensitive)
+    QVector<QString> foldedUniversiteAdi;
+    QVector<QString> foldedProgramAdi;
+
+    // Position of every row in the ascending order of a column (NULL first, ties
+    // in row order), so sorting any row subset compares integers only.
+    // Empty for a column until buildSortRanks() or computeSortRanks() fills it.
+    std::array<QVector<int>, ProgramTableColumnCount> sortRanks;
+
+    void clear();
+    // Returns false when isCancelled() stopped the load before the last row.
+    // maxRows >= 0 stops after that many rows, a later call continues with the next row.
+    bool appendFromQuery(QSqlQuery &query, const std::function<bool()> &isCancelled = nullptr, int maxRows = -1);
+
+    QVariant displayData(int row, int column) const;
+    double number(int row, ProgramTableColumns column) const;
+    const QString &text(int row, ProgramTableColumns column) const;
+    bool isColumnAvailable(ProgramTableColumns column) const;
+
+    void buildSortRanks();
+    QVector<int> computeSortRanks(int column) const;
+    // Sorts rowIds by column, a negative column means ProgramKodu order
+    void sortRows(QVector<int> &rowIds, int column, Qt::SortOrder order) const;
+
+    static QString dbColumnName(ProgramTableColumns column);
+    static bool isTextColumn(ProgramTableColumns column);
+    static QString foldForLike(const QString &text);
+};
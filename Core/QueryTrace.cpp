@@ -0,0 +1,204 @@
+/*
+QueryTrace class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "QueryTrace.hpp"
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStringList>
+#include <atomic>
+
+namespace {
+
+// Chrome trace thread ids
+constexpr int GuiThreadId = 1;
+constexpr int QueryThreadId = 2;
+
+QMutex mutex;
+QVector<QueryTrace::Record> recordList;
+std::atomic<bool> enabled{false};
+
+const QElapsedTimer &traceClock() {
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return timer;
+}
+
+QString milliseconds(qint64 us) {
+    return QString::number(us / 1000.0, 'f', 1);
+}
+
+QJsonObject threadName(int threadId, const QString &name) {
+    return QJsonObject{
+        {"name", "thread_name"},
+        {"ph", "M"},
+        {"pid", 1},
+        {"tid", threadId},
+        {"args", QJsonObject{{"name", name}}}
+    };
+}
+
+}
+
+qint64 QueryTrace::Record::totalUs() const {
+    qint64 first = requestedUs;
+    qint64 last = -1;
+    for (const Span &span : phases) {
+        if (!span.isValid())
+            continue;
+        if (first < 0 || span.startUs < first)
+            first = span.startUs;
+        last = qMax(last, span.startUs + span.durationUs);
+    }
+    return first < 0 || last < 0 ? 0 : last - first;
+}
+
+qint64 QueryTrace::nowUs() {
+    return traceClock().nsecsElapsed() / 1000;
+}
+
+QueryTrace::Span QueryTrace::spanSince(qint64 startUs) {
+    return {startUs, nowUs() - startUs};
+}
+
+void QueryTrace::setEnabled(bool on) {
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+bool QueryTrace::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void QueryTrace::append(const Record &record) {
+    if (!isEnabled())
+        return;
+    QMutexLocker locker(&mutex);
+    if (recordList.size() >= MaxRecords)
+        recordList.remove(0, recordList.size() - MaxRecords + 1);
+    recordList.append(record);
+}
+
+QVector<QueryTrace::Record> QueryTrace::records() {
+    QMutexLocker locker(&mutex);
+    return recordList;
+}
+
+void QueryTrace::clear() {
+    QMutexLocker locker(&mutex);
+    recordList.clear();
+}
+
+QString QueryTrace::phaseName(Phase phase) {
+    switch (phase) {
+    case Build: return "SQL build";
+    case Exec: return "SQL exec";
+    case Fetch: return "row fetch";
+    case Filter: return "store filter";
+    case Model: return "model";
+    case Paint: return "paint";
+    default: return QString();
+    }
+}
+
+QString QueryTrace::summary(const Record &record) {
+    QStringList parts;
+    if (record.fromStore) {
+        parts.append(QStringLiteral("%1 %2 ms").arg(record.cacheHit ? "önbellek" : (record.refined ? "daraltma" : "filtre"),
+                                                   milliseconds(record.phases[Filter].durationUs)));
+    }
+    else {
+        parts.append(QStringLiteral("SQL %1 ms").arg(milliseconds(record.phases[Build].durationUs)));
+        parts.append(QStringLiteral("exec %1 ms").arg(milliseconds(record.phases[Exec].durationUs)));
+        parts.append(QStringLiteral("okuma %1 ms").arg(milliseconds(record.phases[Fetch].durationUs)));
+    }
+    parts.append(QStringLiteral("model %1 ms").arg(milliseconds(record.phases[Model].durationUs)));
+    parts.append(QStringLiteral("çizim %1 ms").arg(milliseconds(record.phases[Paint].durationUs)));
+    parts.append(QStringLiteral("toplam %1 ms").arg(milliseconds(record.totalUs())));
+    parts.append(QStringLiteral("%1 satır").arg(record.rowCount));
+    if (record.cacheLookups > 0)
+        parts.append(QStringLiteral("önbellek isabeti %%1 (%2/%3)")
+                         .arg(record.cacheHitRate() * 100, 0, 'f', 1)
+                         .arg(record.cacheHits)
+                         .arg(record.cacheLookups));
+    return parts.join(QStringLiteral("  ·  "));
+}
+
+QByteArray QueryTrace::toChromeTrace() {
+    QJsonArray events;
+    events.append(threadName(GuiThreadId, "GUI"));
+    events.append(threadName(QueryThreadId, "ProgramQueryWorker"));
+
+    for (const Record &record : records()) {
+        const QJsonObject args{
+            {"generation", QString::number(record.generation)},
+            {"rows", record.rowCount},
+            {"fromStore", record.fromStore},
+            {"cacheHit", record.cacheHit},
+            {"refined", record.refined},
+            {"cacheHits", record.cacheHits},
+            {"cacheLookups", record.cacheLookups},
+            {"cacheHitRate", record.cacheHitRate()}
+        };
+
+        // The whole interaction on the GUI row, every phase on the thread it ran on
+        qint64 startUs = record.requestedUs;
+        for (const Span &span : record.phases) {
+            if (span.isValid() && (startUs < 0 || span.startUs < startUs))
+                startUs = span.startUs;
+        }
+        if (startUs < 0)
+            continue;
+        events.append(QJsonObject{
+            {"name", "filter change"},
+            {"cat", "query"},
+            {"ph", "X"},
+            {"pid", 1},
+            {"tid", GuiThreadId},
+            {"ts", double(startUs)},
+            {"dur", double(record.totalUs())},
+            {"args", args}
+        });
+
+        for (int phase = 0; phase < PhaseCount; phase++) {
+            const Span &span = record.phases[phase];
+            if (!span.isValid())
+                continue;
+            events.append(QJsonObject{
+                {"name", phaseName(static_cast<Phase>(phase))},
+                {"cat", "query"},
+                {"ph", "X"},
+                {"pid", 1},
+                {"tid", phase >= Model ? GuiThreadId : QueryThreadId},
+                {"ts", double(span.startUs)},
+                {"dur", double(span.durationUs)}
+            });
+        }
+    }
+
+    QJsonObject trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+bool QueryTrace::exportChromeTrace(const QString &path) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(toChromeTrace());
+    return file.commit();
+}
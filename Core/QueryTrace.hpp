@@ -0,0 +1,85 @@
+/*
+QueryTrace class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <array>
+
+// Where the time of every filter change goes, from the widget change to the
+// repaint of the program table. The query engine times its phases into the
+// record of each result, the window adds the model and paint phases and
+// appends the record once the table is painted. Records are kept only while
+// tracing is enabled and can be exported as Chrome trace events
+// (chrome://tracing, ui.perfetto.dev). append() may be called from any thread.
+class QueryTrace
+{
+public:
+    enum Phase {
+        // SQLite fallback: compiling and binding the statement, exec(), reading the rows
+        Build = 0,
+        Exec,
+        Fetch,
+        // Program store: the filter pass or the result cache lookup
+        Filter,
+        // GUI thread: handing the rows to the model, painting the table
+        Model,
+        Paint,
+        PhaseCount
+    };
+
+    // Microseconds on the nowUs() clock, startUs is -1 for a phase that did not run
+    struct Span {
+        qint64 startUs = -1;
+        qint64 durationUs = 0;
+
+        bool isValid() const { return startUs >= 0; }
+    };
+
+    struct Record {
+        quint64 generation = 0;
+        // When the filter changed, the debounce delay is part of the interaction
+        qint64 requestedUs = -1;
+        bool fromStore = false;
+        bool cacheHit = false;
+        bool refined = false;
+        int rowCount = 0;
+        // Result cache counters of the engine after this query
+        int cacheHits = 0;
+        int cacheLookups = 0;
+
+        // Share of the lookups answered by the result cache so far, 0 before the first one
+        double cacheHitRate() const { return cacheLookups > 0 ? double(cacheHits) / cacheLookups : 0.0; }
+        std::array<Span, PhaseCount> phases;
+
+        // From requestedUs (or the first phase) to the end of the last phase
+        qint64 totalUs() const;
+    };
+
+    static constexpr int MaxRecords = 1000;
+
+    static qint64 nowUs();
+    static Span spanSince(qint64 startUs);
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+    // Ignored while tracing is disabled, the oldest records are dropped after MaxRecords
+    static void append(const Record &record);
+    static QVector<Record> records();
+    static void clear();
+
+    static QString phaseName(Phase phase);
+    // One line for the status bar
+    static QString summary(const Record &record);
+    static QByteArray toChromeTrace();
+    static bool exportChromeTrace(const QString &path);
+};
@@ -0,0 +1,50 @@
+/*
+RankIndex class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "RankIndex.hpp"
+#include <algorithm>
+#include <cmath>
+
+void RankIndex::build(const QVector<double> &columnValues) {
+    clear();
+
+    rows.reserve(columnValues.size());
+    for (int row = 0; row < columnValues.size(); row++) {
+        if (!std::isnan(columnValues.at(row)))
+            rows.append(row);
+    }
+    // Equal ranks keep the row order, a slice of them is already sorted by ProgramKodu
+    std::stable_sort(rows.begin(), rows.end(), [&columnValues](int a, int b) {
+        return columnValues.at(a) < columnValues.at(b);
+    });
+
+    values.reserve(rows.size());
+    for (int row : rows)
+        values.append(columnValues.at(row));
+}
+
+void RankIndex::clear() {
+    values.clear();
+    rows.clear();
+}
+
+RankIndex::Slice RankIndex::find(double lower, double upper) const {
+    Slice slice;
+    if (lower > upper || values.isEmpty())
+        return slice;
+
+    const double *begin = values.constData();
+    const double *end = begin + values.size();
+    const double *first = std::lower_bound(begin, end, lower);
+    const double *last = std::upper_bound(first, end, upper);
+    slice.first = rows.constData() + (first - begin);
+    slice.last = rows.constData() + (last - begin);
+    return slice;
+}
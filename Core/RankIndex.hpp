@@ -0,0 +1,38 @@
+/*
+RankIndex class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QVector>
+
+// Rows of a numeric column in ascending order of their values, empty (NaN)
+// cells left out. A range query is two binary searches, the matching rows
+// are the contiguous slice between them instead of a comparison per row.
+class RankIndex
+{
+public:
+    // Rows [first, last) of a range, in ascending order of their values
+    struct Slice {
+        const int *first = nullptr;
+        const int *last = nullptr;
+        int size() const { return int(last - first); }
+    };
+
+    void build(const QVector<double> &values);
+    void clear();
+    int size() const { return int(rows.size()); }
+
+    // Rows with lower <= value <= upper
+    Slice find(double lower, double upper) const;
+
+private:
+    QVector<double> values;
+    QVector<int> rows;
+};
@@ -0,0 +1,75 @@
+/*
+ResultCache class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ResultCache.hpp"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include "ProgramStore.hpp"
+
+ResultCache::ResultCache(int capacity)
+{
+    // Every result costs 1, so the cache holds at most capacity results
+    results.setMaxCost(capacity);
+}
+
+QByteArray ResultCache::keyFor(const ProgramFilter &filter) {
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_12);
+
+    stream << qint32(filter.tercihTuru)
+           << ProgramStore::universityNeedle(filter)
+           << ProgramStore::departmentNeedle(filter)
+           << qint32(filter.ulke)
+           << qint32(filter.lisansTuru)
+           << qint32(filter.universiteTuru)
+           << qint32(filter.puanTuru);
+
+    // Bounds at the slider limits do not filter anything
+    stream << (filter.hasMinimumScore() ? filter.enKucukPuan : ProgramFilter::EnKucukPuanSiniri)
+           << (filter.hasMaximumScore() ? filter.enBuyukPuan : ProgramFilter::EnBuyukPuanSiniri);
+    stream << qint32(filter.hasMinimumRank() ? filter.enKucukBasariSirasi : 0)
+           << qint32(filter.hasMaximumRank() ? filter.enBuyukBasariSirasi : 0);
+
+    stream << filter.genel << filter.okulBirincisi << filter.sehitGaziYakini
+           << filter.depremzede << filter.kadin34 << filter.kktcUyruklu << filter.mtok
+           << filter.ucretsiz << filter.indirimli << filter.ucretli;
+
+    // The default ProgramKodu order has no direction
+    const bool sorted = filter.sortColumn >= 0;
+    stream << qint32(sorted ? filter.sortColumn : -1)
+           << qint32(sorted ? filter.sortOrder : Qt::AscendingOrder);
+
+    return QCryptographicHash::hash(state, QCryptographicHash::Sha1);
+}
+
+bool ResultCache::find(const ProgramFilter &filter, QVector<int> &rowIds) {
+    if (const QVector<int> *cached = results.object(keyFor(filter))) {
+        hitCount++;
+        rowIds = *cached;
+        return true;
+    }
+    missCount++;
+    return false;
+}
+
+void ResultCache::insert(const ProgramFilter &filter, const QVector<int> &rowIds) {
+    // QVector is implicitly shared, the cached copy does not duplicate the ids
+    results.insert(keyFor(filter), new QVector<int>(rowIds));
+}
+
+void ResultCache::clear() {
+    results.clear();
+}
+
+double ResultCache::hitRate() const {
+    const int total = hitCount + missCount;
+    return total == 0 ? 0.0 : double(hitCount) / total;
+}
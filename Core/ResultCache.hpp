@@ -0,0 +1,46 @@
+/*
+ResultCache class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QVector>
+#include "ProgramFilter.hpp"
+
+// Least recently used set of program store results, keyed by a hash of the
+// canonical filter state. Flipping a checkbox back or switching the tercih
+// türü back and forth is then answered without running the filter again.
+class ResultCache
+{
+public:
+    static constexpr int DefaultCapacity = 64;
+
+    explicit ResultCache(int capacity = DefaultCapacity);
+
+    // Filters that always give the same rows share a key: search texts are
+    // folded like the search, unused score bounds and sort orders are dropped
+    static QByteArray keyFor(const ProgramFilter &filter);
+
+    // Returns true and sets rowIds if the result of filter is cached
+    bool find(const ProgramFilter &filter, QVector<int> &rowIds);
+    void insert(const ProgramFilter &filter, const QVector<int> &rowIds);
+    void clear();
+
+    int hits() const { return hitCount; }
+    int misses() const { return missCount; }
+    // Ratio of find() calls answered from the cache, 0 before the first call
+    double hitRate() const;
+
+private:
+    QCache<QByteArray, QVector<int>> results;
+    int hitCount = 0;
+    int missCount = 0;
+};
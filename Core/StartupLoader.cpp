@@ -0,0 +1,64 @@
+/*
+StartupLoader class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "StartupLoader.hpp"
+#include <QDebug>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <utility>
+#include "CatalogSnapshot.hpp"
+#include "ProgramDelta.hpp"
+#include "StartupTimeline.hpp"
+#include "../Utils/SQLiteUtil.hpp"
+
+StartupLoader::StartupLoader(const QString &databasePath)
+    : databasePath(databasePath)
+    , connectionName(QStringLiteral("StartupLoader_%1").arg(quintptr(this), 0, 16))
+{
+    qRegisterMetaType<ProgramCatalog>();
+}
+
+StartupLoader::~StartupLoader() {
+    if (QSqlDatabase::contains(connectionName))
+        QSqlDatabase::removeDatabase(connectionName);
+}
+
+ProgramStore StartupLoader::takeStore() {
+    return std::move(store);
+}
+
+QString StartupLoader::openedDatabasePath() const {
+    return databasePath;
+}
+
+void StartupLoader::run() {
+    // Only rebuilds the patched copy when the database or a delta file changed
+    databasePath = ProgramDeltaEngine::patchedDatabase(databasePath);
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        const bool opened = SQLiteUtil::openDatabase(db, databasePath);
+        if (!opened)
+            qDebug() << "Veritabanı açılamadı:" << db.lastError().text();
+        StartupTimeline::mark("database opened");
+        emit databaseOpened(opened);
+
+        if (opened) {
+            const ProgramCatalog catalog = CatalogSnapshot::load(db);
+            StartupTimeline::mark("catalog loaded");
+            emit catalogReady(catalog);
+
+            store.load(db);
+            StartupTimeline::mark("program store loaded");
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    emit storeReady();
+}
@@ -0,0 +1,48 @@
+/*
+StartupLoader class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include "ProgramCatalog.hpp"
+#include "ProgramStore.hpp"
+
+Q_DECLARE_METATYPE(ProgramCatalog)
+
+// Runs the database work of the startup on a background thread, while the
+// window is already shown. Stages are reported one by one as they finish:
+// databaseOpened(), catalogReady() and storeReady().
+class StartupLoader : public QObject {
+    Q_OBJECT
+public:
+    explicit StartupLoader(const QString &databasePath);
+    ~StartupLoader();
+
+    // Moves the loaded tables out, only after storeReady()
+    ProgramStore takeStore();
+    // The database that was opened, the patched copy when there are delta files.
+    // Valid after databaseOpened()
+    QString openedDatabasePath() const;
+
+public slots:
+    void run();
+
+signals:
+    void databaseOpened(bool ok);
+    void catalogReady(const ProgramCatalog &catalog);
+    void storeReady();
+
+private:
+    QString databasePath;
+    QString connectionName;
+    ProgramStore store;
+};
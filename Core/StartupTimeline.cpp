@@ -0,0 +1,67 @@
+/*
+StartupTimeline class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "StartupTimeline.hpp"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <utility>
+
+namespace {
+
+QMutex mutex;
+QElapsedTimer timer;
+QVector<StartupTimeline::Stage> stageList;
+
+}
+
+void StartupTimeline::start() {
+    QMutexLocker locker(&mutex);
+    stageList.clear();
+    timer.start();
+}
+
+void StartupTimeline::mark(const QString &stage) {
+    QMutexLocker locker(&mutex);
+    if (!timer.isValid())
+        timer.start();
+    for (const Stage &existing : std::as_const(stageList)) {
+        if (existing.name == stage)
+            return;
+    }
+    stageList.append({stage, timer.nsecsElapsed() / 1e6});
+}
+
+double StartupTimeline::elapsedMs(const QString &stage) {
+    QMutexLocker locker(&mutex);
+    for (const Stage &existing : std::as_const(stageList)) {
+        if (existing.name == stage)
+            return existing.elapsedMs;
+    }
+    return -1.0;
+}
+
+QVector<StartupTimeline::Stage> StartupTimeline::stages() {
+    QMutexLocker locker(&mutex);
+    return stageList;
+}
+
+void StartupTimeline::report() {
+    for (const Stage &stage : stages())
+        qDebug().noquote() << QStringLiteral("[startup] %1 ms  %2").arg(stage.elapsedMs, 8, 'f', 1).arg(stage.name);
+
+    const double firstPaint = elapsedMs(FirstPaint);
+    if (firstPaint > FirstPaintBudgetMs)
+        qWarning() << "İlk çizim bütçeyi aştı:" << firstPaint << "ms >" << FirstPaintBudgetMs << "ms";
+    const double interactive = elapsedMs(Interactive);
+    if (interactive > InteractiveBudgetMs)
+        qWarning() << "İlk sonuçlar bütçeyi aştı:" << interactive << "ms >" << InteractiveBudgetMs << "ms";
+}
@@ -0,0 +1,40 @@
+/*
+StartupTimeline class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+// Timestamps of the startup stages, measured from start() in main().
+// mark() may be called from any thread.
+class StartupTimeline
+{
+public:
+    // Stage names
+    static constexpr const char *FirstPaint = "first paint";
+    static constexpr const char *Interactive = "first results shown";
+
+    static constexpr double FirstPaintBudgetMs = 300.0;
+    static constexpr double InteractiveBudgetMs = 1500.0;
+
+    struct Stage {
+        QString name;
+        double elapsedMs = 0.0;
+    };
+
+    static void start();
+    // Only the first mark of a stage is kept
+    static void mark(const QString &stage);
+    static double elapsedMs(const QString &stage);
+    static QVector<Stage> stages();
+    // Logs every stage and warns about the ones over their budget
+    static void report();
+};
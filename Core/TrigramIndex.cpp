@@ -0,0 +1,103 @@
+/*
+TrigramIndex class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "TrigramIndex.hpp"
+#include <QLocale>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <utility>
+
+void TrigramIndex::build(const QVector<QString> &texts) {
+    clear();
+    this->texts = texts;
+
+    for (int id = 0; id < this->texts.size(); id++) {
+        const QString &text = this->texts.at(id);
+        for (int i = 0; i + 3 <= text.size(); i++) {
+            QVector<int> &posting = postings[trigramKey(text.constData() + i)];
+            // Ids are visited in order, so every posting list stays sorted and duplicate-free
+            if (posting.isEmpty() || posting.last() != id)
+                posting.append(id);
+        }
+    }
+    for (QVector<int> &posting : postings)
+        posting.squeeze();
+}
+
+void TrigramIndex::clear() {
+    texts.clear();
+    postings.clear();
+}
+
+QVector<int> TrigramIndex::find(const QString &needle) const {
+    QVector<int> ids;
+    find(needle, ids);
+    return ids;
+}
+
+void TrigramIndex::find(const QString &needle, QVector<int> &ids) const {
+    ids.resize(0);
+
+    // Short needles have no trigram, compare the normalized strings directly
+    if (needle.size() < 3) {
+        for (int id = 0; id < texts.size(); id++) {
+            if (texts.at(id).contains(needle))
+                ids.append(id);
+        }
+        return;
+    }
+
+    QVarLengthArray<const QVector<int> *, 32> lists;
+    for (int i = 0; i + 3 <= needle.size(); i++) {
+        const auto it = postings.constFind(trigramKey(needle.constData() + i));
+        if (it == postings.constEnd())
+            return;
+        if (std::find(lists.begin(), lists.end(), &it.value()) == lists.end())
+            lists.append(&it.value());
+    }
+
+    // Shortest lists first, the candidate set only shrinks
+    std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+    ids.append(*lists.first());
+    for (int i = 1; i < lists.size() && !ids.isEmpty(); i++)
+        intersectInPlace(ids, *lists.at(i));
+
+    // Having all trigrams does not mean they are adjacent
+    int kept = 0;
+    for (int id : std::as_const(ids)) {
+        if (texts.at(id).contains(needle))
+            ids[kept++] = id;
+    }
+    ids.resize(kept);
+}
+
+QString TrigramIndex::turkishFold(const QString &text) {
+    static const QLocale turkishLocale(QLocale::Turkish, QLocale::Turkey);
+    return turkishLocale.toLower(text);
+}
+
+quint64 TrigramIndex::trigramKey(const QChar *c) {
+    return (quint64(c[0].unicode()) << 32) | (quint64(c[1].unicode()) << 16) | quint64(c[2].unicode());
+}
+
+void TrigramIndex::intersectInPlace(QVector<int> &candidates, const QVector<int> &list) {
+    int kept = 0;
+    auto it = list.constBegin();
+    for (int id : std::as_const(candidates)) {
+        it = std::lower_bound(it, list.constEnd(), id);
+        if (it == list.constEnd())
+            break;
+        if (*it == id)
+            candidates[kept++] = id;
+    }
+    candidates.resize(kept);
+}
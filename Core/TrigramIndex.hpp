@@ -0,0 +1,46 @@
+/*
+TrigramIndex class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// Substring index over a list of already normalized strings (see turkishFold()
+// and ProgramTable::foldForLike()). A needle of three or more characters is
+// answered by intersecting the posting lists of its trigrams and verifying
+// the few remaining candidates, instead of scanning every string.
+class TrigramIndex
+{
+public:
+    void build(const QVector<QString> &texts);
+    void clear();
+    int size() const { return int(texts.size()); }
+    const QString &text(int id) const { return texts.at(id); }
+
+    // Ids of the texts containing needle, in ascending order.
+    // needle must be normalized the same way as the indexed texts.
+    QVector<int> find(const QString &needle) const;
+    // Same as above into a caller owned buffer, which is not reallocated once
+    // it has grown large enough
+    void find(const QString &needle, QVector<int> &ids) const;
+
+    // Turkish lower case (I -> ı, İ -> i), the folding of the completer search
+    static QString turkishFold(const QString &text);
+
+private:
+    static quint64 trigramKey(const QChar *c);
+    // Keeps the ids of candidates that are also in list, both sorted
+    static void intersectInPlace(QVector<int> &candidates, const QVector<int> &list);
+
+    QVector<QString> texts;
+    QHash<quint64, QVector<int>> postings;
+};
@@ -0,0 +1,115 @@
+/*
+TsvReader class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "TsvReader.hpp"
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+}
+
+QString TsvField::text() const {
+    if (!quoted) {
+        const char *first = data;
+        const char *last = data + size;
+        while (first < last && isSpace(*first))
+            first++;
+        while (last > first && isSpace(last[-1]))
+            last--;
+        return QString::fromUtf8(first, int(last - first));
+    }
+    return QString::fromUtf8(bytes());
+}
+
+QByteArray TsvField::bytes() const {
+    QByteArray value = QByteArray::fromRawData(data, size).trimmed();
+    if (quoted)
+        value.replace("\"\"", "\"");
+    return value;
+}
+
+TsvReader::TsvReader(const char *data, qint64 size, char separator)
+    : current(data)
+    , end(data + size)
+    , separator(separator)
+{
+    if (size >= 3 && quint8(data[0]) == 0xEF && quint8(data[1]) == 0xBB && quint8(data[2]) == 0xBF)
+        current += 3;
+}
+
+char TsvReader::detectSeparator(const char *data, qint64 size) {
+    int tabs = 0;
+    int semicolons = 0;
+    int commas = 0;
+    for (qint64 i = 0; i < size && data[i] != '\n'; i++) {
+        tabs += data[i] == '\t';
+        semicolons += data[i] == ';';
+        commas += data[i] == ',';
+    }
+    if (tabs >= semicolons && tabs >= commas)
+        return '\t';
+    return semicolons >= commas ? ';' : ',';
+}
+
+bool TsvReader::next(TsvRecord &fields) {
+    fields.clear();
+    if (current >= end)
+        return false;
+
+    recordLine = currentLine;
+    while (true) {
+        TsvField field;
+        if (current < end && *current == '"') {
+            // Quoted field, it ends at a quote that is not followed by another one
+            field.quoted = true;
+            field.data = ++current;
+            while (current < end) {
+                if (*current == '"') {
+                    if (current + 1 < end && current[1] == '"') {
+                        current += 2;
+                        continue;
+                    }
+                    break;
+                }
+                if (*current == '\n')
+                    currentLine++;
+                current++;
+            }
+            field.size = int(current - field.data);
+            if (current < end)
+                current++;
+            // Anything between the closing quote and the separator is dropped
+            while (current < end && *current != separator && *current != '\n')
+                current++;
+        }
+        else {
+            field.data = current;
+            while (current < end && *current != separator && *current != '\n')
+                current++;
+            field.size = int(current - field.data);
+            if (field.size > 0 && field.data[field.size - 1] == '\r' && (current == end || *current == '\n'))
+                field.size--;
+        }
+        fields.append(field);
+
+        if (current >= end)
+            return true;
+        if (*current == '\n') {
+            current++;
+            currentLine++;
+            return true;
+        }
+        // Separator, another field follows
+        current++;
+    }
+}
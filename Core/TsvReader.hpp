@@ -0,0 +1,57 @@
+/*
+TsvReader class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVarLengthArray>
+
+// A field of a TsvReader record. It points into the parsed buffer, nothing is copied.
+struct TsvField {
+    const char *data = nullptr;
+    int size = 0;
+    // Enclosed in double quotes, "" inside it stands for one quote
+    bool quoted = false;
+
+    bool isEmpty() const { return size == 0; }
+    // UTF-8 decoded text without the surrounding white space
+    QString text() const;
+    // The bytes without the surrounding white space, quotes unescaped
+    QByteArray bytes() const;
+};
+
+using TsvRecord = QVarLengthArray<TsvField, 24>;
+
+// Tokenizer of the tab separated exports of spreadsheet programs. It walks
+// a buffer (usually a mapped file) once and hands out the fields as views
+// into it. Quoted fields may contain separators and line breaks, CRLF and LF
+// line endings and a UTF-8 BOM are accepted. Comma and semicolon separated
+// CSV files are read the same way with another separator.
+class TsvReader
+{
+public:
+    TsvReader(const char *data, qint64 size, char separator = '\t');
+
+    // The most frequent of tab, semicolon and comma on the first line
+    static char detectSeparator(const char *data, qint64 size);
+
+    // Reads the next record into fields, false at the end of the buffer
+    bool next(TsvRecord &fields);
+    // 1-based line of the record returned by the last next() call
+    int line() const { return recordLine; }
+
+private:
+    const char *current;
+    const char *end;
+    char separator;
+    int currentLine = 1;
+    int recordLine = 0;
+};
@@ -15,6 +15,35 @@ enum class TercihTuru : int {
     EkTercih = 1
 };
 
+// The values below match the item order of the related filter combo boxes
+enum class Ulke : int {
+    Tumu = 0,
+    Turkiye,
+    KKTC,
+    Yurtdisi
+};
+
+enum class LisansTuru : int {
+    Tumu = 0,
+    Lisans,
+    Onlisans
+};
+
+enum class UniversiteTuru : int {
+    Tumu = 0,
+    Devlet,
+    Vakif
+};
+
+enum class PuanTuru : int {
+    Tumu = 0,
+    SAY,
+    EA,
+    SOZ,
+    TYT,
+    DIL
+};
+
 enum class ProgramTableColumns : int {
     ProgramKodu = 0,
     Universite,
@@ -42,3 +71,5 @@ enum class ProgramTableColumns : int {
     Kadin34PlusBasariSirasi,
     Kadin34PlusEnKucukPuan
 };
+
+constexpr int ProgramTableColumnCount = (int) ProgramTableColumns::Kadin34PlusEnKucukPuan + 1;
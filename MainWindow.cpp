@@ -18,7 +18,20 @@ You should have received a copy of the GNU General Public License along with thi
 #include <QStandardItemModel>
 #include <QCollator>
 #include "TurkishFilterProxy.hpp"
+#include "ProgramTableModel.hpp"
+#include "Core/StartupLoader.hpp"
+#include "Core/StartupTimeline.hpp"
+#include "Core/ProgramQueryScheduler.hpp"
+#include "Core/ProgramHistory.hpp"
+#include "Core/QueryTrace.hpp"
+#include <QFileDialog>
+#include <QLabel>
 #include <QLineEdit>
+#include <QMessageBox>
+#include <QShortcut>
+#include <QStatusBar>
+#include <QTimer>
+#include <cmath>
 #include <QCollator>
 #include "AboutDialog.hpp"
 #include <QFile>
@@ -38,18 +51,21 @@ MainWindow::MainWindow(QWidget *parent)
     setLogoDarkMode(DarkModeUtil::isDarkMode());
     ui->doubleSpinBoxEnKucukPuan->setButtonSymbols(QAbstractSpinBox::NoButtons);
     ui->doubleSpinBoxEnBuyukPuan->setButtonSymbols(QAbstractSpinBox::NoButtons);
+    // The bounds of the score range are the open ends of ProgramFilter
+    ui->doubleSpinBoxEnKucukPuan->setRange(ProgramFilter::EnKucukPuanSiniri, ProgramFilter::EnBuyukPuanSiniri);
+    ui->doubleSpinBoxEnBuyukPuan->setRange(ProgramFilter::EnKucukPuanSiniri, ProgramFilter::EnBuyukPuanSiniri);
+    programTableModel = new ProgramTableModel(this);
+    // Broad filters show their first page as quickly as narrow ones
+    programTableModel->setStreaming(true);
+    ui->tableViewPrograms->setModel(programTableModel);
     setProgramTableColumnWidths();
-    initDB();
-    populateUniversitiesComboBox();
-    populateDepartmentsComboBox();
 
     auto *proxyUniversity = new TurkishFilterProxy(this);
+    // The catalog comes sorted (also from its snapshot), the proxies keep its order
     proxyUniversity->setSourceModel(ui->comboBoxUniversity->model());
-    proxyUniversity->sort(0);
 
     auto *proxyDepartment = new TurkishFilterProxy(this);
     proxyDepartment->setSourceModel(ui->comboBoxDepartment->model());
-    proxyDepartment->sort(0);
 
     auto *completerUniversity = new QCompleter(proxyUniversity, this);
     completerUniversity->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
@@ -72,16 +88,84 @@ MainWindow::MainWindow(QWidget *parent)
             proxyDepartment, [proxyDepartment](const QString &t){ proxyDepartment->setNeedle(t); });
 
 
-    hideUnusedColumnsOnTheProgramTable();
     hideUnnecessaryColumnsOnTheProgramTable();
-    populateProgramTable();
 
-    programTableHorizontalHeader = ui->tableWidgetPrograms->horizontalHeader();
+    programTableHorizontalHeader = ui->tableViewPrograms->horizontalHeader();
     programTableHorizontalHeader->setSortIndicatorShown(true);
     connect(programTableHorizontalHeader, &QHeaderView::sectionClicked, this, &MainWindow::onProgramTableHeaderItemClicked);
+    connect(ui->tableViewPrograms, &QTableView::doubleClicked, this, &MainWindow::onProgramTableDoubleClicked);
+
+    // Query timings: F12 shows them in the status bar, Ctrl+Shift+E saves them as a Chrome trace
+    queryTraceLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(queryTraceLabel, 1);
+    statusBar()->hide();
+    ui->tableViewPrograms->viewport()->installEventFilter(this);
+    connect(new QShortcut(QKeySequence(Qt::Key_F12), this), &QShortcut::activated, this, &MainWindow::toggleQueryTrace);
+    connect(new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+E")), this), &QShortcut::activated, this, &MainWindow::exportQueryTrace);
+
+    startLoading();
+    StartupTimeline::mark("window constructed");
+}
+
+// The window is shown with empty lists, the database work streams in from the startup loader
+void MainWindow::startLoading() {
+    databasePath = SQLiteUtil::resolveDatabasePath();
+    ui->comboBoxUniversity->setEnabled(false);
+    ui->comboBoxDepartment->setEnabled(false);
+    ui->comboBoxUniversity->lineEdit()->setPlaceholderText(tr("Yükleniyor..."));
+    ui->comboBoxDepartment->lineEdit()->setPlaceholderText(tr("Yükleniyor..."));
+
+    auto *loader = new StartupLoader(databasePath);
+    loader->moveToThread(&startupThread);
+    connect(&startupThread, &QThread::started, loader, &StartupLoader::run);
+    connect(&startupThread, &QThread::finished, loader, &QObject::deleteLater);
+    connect(loader, &StartupLoader::databaseOpened, this, [this, loader](bool ok) {
+        databaseAvailable = ok;
+        databasePath = loader->openedDatabasePath();
+    });
+    connect(loader, &StartupLoader::catalogReady, this, &MainWindow::onCatalogReady);
+    connect(loader, &StartupLoader::storeReady, this, [this, loader]() {
+        // The loader is done with the store, it is moved over before the thread quits
+        onStoreReady(loader->takeStore());
+        startupThread.quit();
+    });
+    startupThread.start();
+}
+
+void MainWindow::onCatalogReady(const ProgramCatalog &catalog) {
+    populateUniversitiesComboBox(catalog);
+    populateDepartmentsComboBox(catalog);
+    ui->comboBoxUniversity->lineEdit()->setPlaceholderText(QString());
+    ui->comboBoxDepartment->lineEdit()->setPlaceholderText(QString());
+    ui->comboBoxUniversity->setEnabled(true);
+    ui->comboBoxDepartment->setEnabled(true);
+    StartupTimeline::mark("combo boxes filled");
+}
+
+void MainWindow::onStoreReady(ProgramStore store) {
+    programStore = std::move(store);
+    // The başarı sırası columns depend on the loaded tables
+    hideUnnecessaryColumnsOnTheProgramTable();
+    if (!databaseAvailable) {
+        StartupTimeline::report();
+        return;
+    }
+
+    programQueryScheduler = new ProgramQueryScheduler(&programStore, databasePath, this);
+    // Earlier years lie next to the shipped database, not next to its patched copy
+    programHistory = new ProgramHistory(ProgramHistory::defaultHistoryDirectory(SQLiteUtil::resolveDatabasePath()));
+    connect(programQueryScheduler, &ProgramQueryScheduler::resultReady, this, &MainWindow::onProgramQueryResultReady);
+    // The first result is shown without the typing delay
+    const ProgramFilter filter = currentProgramFilter();
+    if (filter.canMatch()) {
+        queryRequestedUs = QueryTrace::nowUs();
+        programQueryScheduler->schedule(filter, 0);
+    }
 }
 
 bool MainWindow::event(QEvent *e) {
+    if (e->type() == QEvent::Paint)
+        StartupTimeline::mark(StartupTimeline::FirstPaint);
     if (e->type() == QEvent::ApplicationPaletteChange ||
         e->type() == QEvent::ThemeChange) {
         setLogoDarkMode(DarkModeUtil::isDarkMode());
@@ -91,6 +175,41 @@ bool MainWindow::event(QEvent *e) {
 }
 
 
+bool MainWindow::eventFilter(QObject *watched, QEvent *e) {
+    if (queryTracePaintPending && e->type() == QEvent::Paint && watched == ui->tableViewPrograms->viewport()) {
+        queryTracePaintPending = false;
+        // The paint event is handled after the filters, the timer fires once it is done
+        const qint64 paintStartUs = QueryTrace::nowUs();
+        QTimer::singleShot(0, this, [this, paintStartUs]() {
+            pendingQueryTrace.phases[QueryTrace::Paint] = QueryTrace::spanSince(paintStartUs);
+            QueryTrace::append(pendingQueryTrace);
+            queryTraceLabel->setText(QueryTrace::summary(pendingQueryTrace));
+        });
+    }
+    return QMainWindow::eventFilter(watched, e);
+}
+
+void MainWindow::toggleQueryTrace() {
+    const bool enabled = !QueryTrace::isEnabled();
+    QueryTrace::setEnabled(enabled);
+    queryTracePaintPending = false;
+    queryTraceLabel->setText(tr("Sorgu süreleri bir sonraki filtre değişikliğinde gösterilecek"));
+    statusBar()->setVisible(enabled);
+}
+
+void MainWindow::exportQueryTrace() {
+    if (QueryTrace::records().isEmpty()) {
+        QMessageBox::information(this, tr("Sorgu Süreleri"), tr("Kaydedilecek sorgu yok, önce F12 ile ölçümü açın."));
+        return;
+    }
+    const QString path = QFileDialog::getSaveFileName(this, tr("Sorgu Sürelerini Kaydet"), "AcademyScopeTrace.json",
+                                                      tr("Chrome Trace (*.json)"));
+    if (path.isEmpty())
+        return;
+    if (!QueryTrace::exportChromeTrace(path))
+        QMessageBox::warning(this, tr("Sorgu Süreleri"), tr("Dosya yazılamadı: %1").arg(path));
+}
+
 void MainWindow::onProgramTableHeaderItemClicked(int logicalIndex) {
     qDebug()<<"item clicked " << getDbColumnNameFromProgramTableColumnIndex(logicalIndex);
     // When clicked to the title of a row again, change the order direction
@@ -102,11 +221,43 @@ void MainWindow::onProgramTableHeaderItemClicked(int logicalIndex) {
         lastSortOrder = Qt::AscendingOrder;
     }
     programTableHorizontalHeader->setSortIndicator(lastSortCol, lastSortOrder);
-    populateProgramTable();
+    // The loaded rows are re-sorted in place, the filter result does not change
+    programTableModel->sort(lastSortCol, lastSortOrder);
+}
+
+// Shows the earlier years of the program, one indexed lookup per year
+void MainWindow::onProgramTableDoubleClicked(const QModelIndex &index) {
+    if (programHistory == nullptr || !programHistory->isAvailable() || !index.isValid())
+        return;
+
+    const QModelIndex programKoduIndex = programTableModel->index(index.row(), (int) ProgramTableColumns::ProgramKodu);
+    const qint64 programKodu = programTableModel->data(programKoduIndex).toLongLong();
+    const QString program = programTableModel->data(programTableModel->index(index.row(), (int) ProgramTableColumns::Program)).toString();
+    const QVector<ProgramYearRecord> records = programHistory->series(programKodu, tercihTuru);
+
+    const auto number = [this](double value, int decimals) {
+        return std::isnan(value) ? QStringLiteral("-") : turkishLocale.toString(value, 'f', decimals);
+    };
+    QStringList lines;
+    for (const ProgramYearRecord &record : records) {
+        lines.append(tr("%1: taban puan %2, başarı sırası %3, kontenjan %4, yerleşen %5")
+                         .arg(record.yil)
+                         .arg(number(record.genelEnKucukPuan, 5), number(record.genelBasariSirasi, 0),
+                              number(record.genelKontenjan, 0), number(record.genelYerlesen, 0)));
+    }
+    if (lines.isEmpty())
+        lines.append(tr("Geçmiş yıllarda bu programa ait kayıt yok."));
+
+    QMessageBox::information(this, tr("%1 - %2").arg(programKodu).arg(program), lines.join("\n"));
 }
 
 MainWindow::~MainWindow()
 {
+    // The worker threads use programStore, stop them before the members are destroyed
+    startupThread.quit();
+    startupThread.wait();
+    delete programQueryScheduler;
+    delete programHistory;
     delete ui;
 }
 
@@ -115,532 +266,239 @@ void MainWindow::on_comboBoxUniversity_editTextChanged(const QString &arg1)
     populateProgramTable();
 }
 
-void MainWindow::initDB() {
-    db = QSqlDatabase::addDatabase("QSQLITE");
-
-    QString dbPath = SQLiteUtil::resolveDatabasePath();
-
-    db.setDatabaseName(dbPath);
-
-    if (!db.open()) {
-        qDebug() << "Veritabanı açılamadı:" << db.lastError().text();
-        return;
-    }
-}
-
 void MainWindow::setProgramTableColumnWidths() {
-    ui->tableWidgetPrograms->setColumnWidth((int) ProgramTableColumns::ProgramKodu, 100);
-    ui->tableWidgetPrograms->setColumnWidth((int) ProgramTableColumns::Universite, 300);
-    ui->tableWidgetPrograms->setColumnWidth((int) ProgramTableColumns::Kampus, 170);
-    ui->tableWidgetPrograms->setColumnWidth((int) ProgramTableColumns::Program, 300);
-    ui->tableWidgetPrograms->setColumnWidth((int) ProgramTableColumns::PuanTuru, 40);
-    ui->tableWidgetPrograms->setColumnWidth((int) ProgramTableColumns::GenelKontenjan, 60);
-    ui->tableWidgetPrograms->setColumnWidth((int) ProgramTableColumns::GenelYerlesen, 60);
-    ui->tableWidgetPrograms->setColumnWidth((int) ProgramTableColumns::GenelEnKucukPuan, 100);
+    ui->tableViewPrograms->setColumnWidth((int) ProgramTableColumns::ProgramKodu, 100);
+    ui->tableViewPrograms->setColumnWidth((int) ProgramTableColumns::Universite, 300);
+    ui->tableViewPrograms->setColumnWidth((int) ProgramTableColumns::Kampus, 170);
+    ui->tableViewPrograms->setColumnWidth((int) ProgramTableColumns::Program, 300);
+    ui->tableViewPrograms->setColumnWidth((int) ProgramTableColumns::PuanTuru, 40);
+    ui->tableViewPrograms->setColumnWidth((int) ProgramTableColumns::GenelKontenjan, 60);
+    ui->tableViewPrograms->setColumnWidth((int) ProgramTableColumns::GenelYerlesen, 60);
+    ui->tableViewPrograms->setColumnWidth((int) ProgramTableColumns::GenelEnKucukPuan, 100);
 }
 
-void MainWindow::populateUniversitiesComboBox() {
+void MainWindow::populateUniversitiesComboBox(const ProgramCatalog &catalog) {
     QStandardItemModel* model = qobject_cast<QStandardItemModel*>(ui->comboBoxUniversity->model());
     /*
     QStandardItem* firstItem = model->item(0);
     firstItem->setFlags(firstItem->flags() & ~Qt::ItemIsEnabled);
     firstItem->setForeground(QBrush(Qt::gray));
     */
-    QSqlQuery query;
-    QList<QPair<int, QString>> universities;
-
-    if (query.exec("SELECT UniversiteID, UniversiteAdi FROM Universiteler")) {
-        while (query.next()) {
-            int id = query.value(0).toInt();
-            QString name = query.value(1).toString();
-            universities.append(qMakePair(id, name));
-        }
-    }
-
-    // Türkçe collator ile sırala
-    QCollator collator(QLocale(QLocale::Turkish, QLocale::Turkey));
-    std::sort(universities.begin(), universities.end(),
-              [&](const QPair<int, QString> &a, const QPair<int, QString> &b) {
-                  return collator.compare(a.second, b.second) < 0;
-              });
-
-    // ComboBox’a ekle
-    for (auto &u : universities) {
-        ui->comboBoxUniversity->addItem(u.second, u.first);
-    }
+    // ComboBox’a tek seferde ekle
+    QList<QStandardItem*> items;
+    items.reserve(catalog.universities.size());
+    for (const auto &u : catalog.universities) {
+        auto *item = new QStandardItem(u.name);
+        item->setData(u.id, Qt::UserRole);
+        items.append(item);
+    }
+    model->invisibleRootItem()->insertRows(model->rowCount(), items);
     ui->comboBoxUniversity->clearEditText();
 }
 
-void MainWindow::populateDepartmentsComboBox() {
+void MainWindow::populateDepartmentsComboBox(const ProgramCatalog &catalog) {
     QStandardItemModel* model = qobject_cast<QStandardItemModel*>(ui->comboBoxDepartment->model());
     /*
     QStandardItem* firstItem = model->item(0);
     firstItem->setFlags(firstItem->flags() & ~Qt::ItemIsEnabled);
     firstItem->setForeground(QBrush(Qt::gray));
     */
-    QSqlQuery query;
-    QList<QString> departments;
-
-    QString selectionQuery = "SELECT DISTINCT\n\
-        TRIM(\n\
-            CASE\n\
-                WHEN instr(ProgramAdi, '(') > 0\n\
-            THEN substr(ProgramAdi, 1, instr(ProgramAdi, '(') - 1)\n\
-            ELSE ProgramAdi\n\
-                END\n\
-            ) AS AnaProgramAdi\n\
-            FROM YKS;\
-           ";
-
-    if (query.exec(selectionQuery)) {
-        while (query.next()) {
-            QString department = query.value(0).toString();
-            departments.append(department);
-        }
-    }
-
-    QCollator collator(QLocale(QLocale::Turkish, QLocale::Turkey));
-    std::sort(departments.begin(), departments.end(),
-              [&](const QString &a, const QString &b) {
-                  return collator.compare(a, b) < 0;
-              });
-
-    for (auto &department : departments) {
-        ui->comboBoxDepartment->addItem(department);
+    QList<QStandardItem*> items;
+    items.reserve(catalog.departments.size());
+    for (const auto &department : catalog.departments) {
+        items.append(new QStandardItem(department));
     }
+    model->invisibleRootItem()->insertRows(model->rowCount(), items);
     ui->comboBoxDepartment->clearEditText();
 }
 
 
 void MainWindow::populateProgramTable(){
-    ui->tableWidgetPrograms->clearContents();
-    ui->tableWidgetPrograms->setRowCount(0);
-
-    if (!db.isOpen())
+    // Not available before the startup loader has finished or when the database could not be opened
+    if (programQueryScheduler == nullptr) {
+        programTableModel->clear();
         return;
-
-    hideUnnecessaryColumnsOnTheProgramTable();
-
-    ui->tableWidgetPrograms->setUpdatesEnabled(false);
-    ui->tableWidgetPrograms->setSortingEnabled(false);
-
-    QString universityName = ui->comboBoxUniversity->currentText();
-    QString department = ui->comboBoxDepartment->currentText();
-    universityName = turkishLocale.toUpper(universityName);
-    QSqlQuery query;
-
-    QStringList whereQueries;
-    QStringList kontenjanQueries;
-    QStringList tuitionQueries;
-    QStringList gradeIntervalQueries;
-    QString kontenjanSubQuery = "";
-    QString tuitionSubQuery = "";
-    QString gradeIntervalSubQuery = "";
-    QList<QPair<int, QString>> universities;
-
-    QString sqlQuery = "Select * FROM ";
-    if(tercihTuru == TercihTuru::NormalTercih)
-        sqlQuery += "YKS";
-    else if(tercihTuru == TercihTuru::EkTercih)
-        sqlQuery += "EkTercihDetayli";
-
-    if(universityName.trimmed() != "") {
-        whereQueries.append("UniversiteAdi LIKE \"%" + StringUtil::toTurkishUpperCase(universityName) + "%\"");
-    }
-
-    if(department.trimmed() != "") {
-        whereQueries.append("ProgramAdi LIKE \"%" + StringUtil::toTurkishTitleCase(department) + "%\"");
-    }
-
-    int ulkeIndex = ui->comboBoxUlke->currentIndex();
-    if(ulkeIndex == 1) { //Turkiye
-        whereQueries.append("UlkeKodu = 90");
-    }
-    else if(ulkeIndex == 2) { //Kibris
-        whereQueries.append("UlkeKodu = 357");
-    }
-    else if(ulkeIndex == 3) { //Yurtdisi
-        whereQueries.append("UlkeKodu <> 90");
-        whereQueries.append("UlkeKodu <> 357");
-    }
-
-    if(ui->comboBoxLicenseType->currentIndex() == 1) {
-        whereQueries.append("Lisans = 1");
-    }
-    else if(ui->comboBoxLicenseType->currentIndex() == 2) {
-        whereQueries.append("Lisans = 0");
-    }
-
-    if(ui->comboBoxUniversityType->currentIndex() == 1) { // Devlet
-        whereQueries.append("DevletUniversitesi = 1");
-    }
-    else if(ui->comboBoxUniversityType->currentIndex() == 2) { //Vakıf
-        whereQueries.append("DevletUniversitesi = 0");
-    }
-
-    int puanTuruIndex = ui->comboBoxPuanTuru->currentIndex();
-    switch(puanTuruIndex) {
-    case 1:
-        whereQueries.append("PuanTuru = \"SAY\"");
-        break;
-    case 2:
-        whereQueries.append("PuanTuru = \"EA\"");
-        break;
-    case 3:
-        whereQueries.append("PuanTuru = \"SÖZ\"");
-        break;
-    case 4:
-        whereQueries.append("PuanTuru = \"TYT\"");
-        break;
-    case 5:
-        whereQueries.append("PuanTuru = \"DİL\"");
-        break;
-    }
-
-    double enKucukPuan = ui->doubleSpinBoxEnKucukPuan->value();
-    double enBuyukPuan = ui->doubleSpinBoxEnBuyukPuan->value();
-
-    QString genelPuanAraligiQuery = "";
-    if(ui->checkBoxGenel->isChecked() || ui->checkBoxKKTCUyruklu->isChecked() || ui->checkBoxMTOK->isChecked()) {
-        if(enKucukPuan > 100) {
-            genelPuanAraligiQuery = "GenelEnKucukPuan > " + QString::number(enKucukPuan);
-        }
-        if(enBuyukPuan < 560) {
-            if(!genelPuanAraligiQuery.isEmpty())
-                genelPuanAraligiQuery += " AND ";
-            genelPuanAraligiQuery += "GenelEnKucukPuan < " + QString::number(enBuyukPuan);
-        }
-        if(!genelPuanAraligiQuery.isEmpty())
-            gradeIntervalQueries.append(genelPuanAraligiQuery);
-    }
-
-    QString okulBirincisiPuanAraligiQuery = "";
-    if(ui->checkBoxOkulBirincisi->isChecked()) {
-        if(enKucukPuan > 100) {
-            okulBirincisiPuanAraligiQuery = "OkulBirincisiEnKucukPuan > " + QString::number(enKucukPuan);
-        }
-        if(enBuyukPuan < 560) {
-            if(!okulBirincisiPuanAraligiQuery.isEmpty())
-                okulBirincisiPuanAraligiQuery += " AND ";
-            okulBirincisiPuanAraligiQuery += "OkulBirincisiEnKucukPuan < " + QString::number(enBuyukPuan);
-        }
-        if(!okulBirincisiPuanAraligiQuery.isEmpty())
-            gradeIntervalQueries.append(okulBirincisiPuanAraligiQuery);
     }
 
-    QString sehitGaziPuanAraligiQuery = "";
-    if(ui->checkBoxSehitGaziYakini->isChecked()) {
-        if(enKucukPuan > 100) {
-            sehitGaziPuanAraligiQuery = "SehitGaziEnKucukPuan > " + QString::number(enKucukPuan);
-        }
-        if(enBuyukPuan < 560) {
-            if(!sehitGaziPuanAraligiQuery.isEmpty())
-                sehitGaziPuanAraligiQuery += " AND ";
-            sehitGaziPuanAraligiQuery += "SehitGaziEnKucukPuan < " + QString::number(enBuyukPuan);
-        }
-        if(!sehitGaziPuanAraligiQuery.isEmpty())
-            gradeIntervalQueries.append(sehitGaziPuanAraligiQuery);
-    }
-
-    QString depremzedePuanAraligiQuery = "";
-    if(ui->checkBoxDepremzede->isChecked()) {
-        if(enKucukPuan > 100) {
-            depremzedePuanAraligiQuery = "DepremzedeEnKucukPuan > " + QString::number(enKucukPuan);
-        }
-        if(enBuyukPuan < 560) {
-            if(!depremzedePuanAraligiQuery.isEmpty())
-                depremzedePuanAraligiQuery += " AND ";
-            depremzedePuanAraligiQuery += "DepremzedeEnKucukPuan < " + QString::number(enBuyukPuan);
-        }
-        if(!depremzedePuanAraligiQuery.isEmpty())
-            gradeIntervalQueries.append(depremzedePuanAraligiQuery);
-    }
-
-    QString kadin34PuanAraligiQuery = "";
-    if(ui->checkBoxKadin34->isChecked()) {
-        if(enKucukPuan > 100) {
-            kadin34PuanAraligiQuery = "Kadin34EnKucukPuan > " + QString::number(enKucukPuan);
-        }
-        if(enBuyukPuan < 560) {
-            if(!kadin34PuanAraligiQuery.isEmpty())
-                kadin34PuanAraligiQuery += " AND ";
-            kadin34PuanAraligiQuery += "Kadin34EnKucukPuan < " + QString::number(enBuyukPuan);
-        }
-        if(!kadin34PuanAraligiQuery.isEmpty())
-            gradeIntervalQueries.append(kadin34PuanAraligiQuery);
-    }
-
-    if(!gradeIntervalQueries.isEmpty()) {
-        gradeIntervalSubQuery += "(" + gradeIntervalQueries[0];
-        for(int i = 1; i < gradeIntervalQueries.size(); i++) {
-            gradeIntervalSubQuery += " OR " + gradeIntervalQueries[i];
-        }
-        gradeIntervalSubQuery += ")";
-    }
-
-    if(!gradeIntervalSubQuery.isEmpty()) {
-        whereQueries.append(gradeIntervalSubQuery);
-    }
-
-    if (ui->checkBoxGenel->isChecked()) {
-        kontenjanQueries.append("GenelKontenjan IS NOT NULL");
-    }
-
-    if (ui->checkBoxOkulBirincisi->isChecked()) {
-        kontenjanQueries.append("OkulBirincisiKontenjan IS NOT NULL");
-    }
-
-    if (ui->checkBoxSehitGaziYakini->isChecked()) {
-        kontenjanQueries.append("SehitGaziKontenjan IS NOT NULL");
-    }
-
-    if (ui->checkBoxDepremzede->isChecked()) {
-        kontenjanQueries.append("DepremzedeKontenjan IS NOT NULL");
-    }
-
-    if (ui->checkBoxKadin34->isChecked()) {
-        kontenjanQueries.append("Kadin34Kontenjan IS NOT NULL");
-    }
+    hideUnnecessaryColumnsOnTheProgramTable();
 
-    if (ui->checkBoxUcretsiz->isChecked()) {
-        tuitionQueries.append("UcretDurumu = 0");
+    const ProgramFilter filter = currentProgramFilter();
+    if(!filter.canMatch()) {
+        programQueryScheduler->cancel();
+        programTableModel->clear();
+        return;
     }
 
-    if (ui->checkBoxIndirimli->isChecked()) {
-        tuitionQueries.append("UcretDurumu = 50");
-    }
+    // The query runs on the worker thread, onProgramQueryResultReady() shows the result
+    queryRequestedUs = QueryTrace::nowUs();
+    programQueryScheduler->schedule(filter);
+}
 
-    if (ui->checkBoxUcretli->isChecked()) {
-        tuitionQueries.append("UcretDurumu = 100");
-    }
+void MainWindow::onProgramQueryResultReady(const ProgramQueryResult &result) {
+    const ProgramFilter &filter = result.filter;
+    const qint64 modelStartUs = QueryTrace::nowUs();
+    if(result.fromStore)
+        programTableModel->setRows(&programStore.table(filter.tercihTuru), result.rowIds, filter.sortColumn, filter.sortOrder);
+    else if(shownFirstPageGeneration == result.generation)
+        programTableModel->appendQueryRows(result.queryTable, result.rowIds, filter.sortColumn, filter.sortOrder);
+    else
+        programTableModel->setQueryRows(result.queryTable, result.rowIds, filter.sortColumn, filter.sortOrder);
+    shownFirstPageGeneration = result.firstPage ? result.generation : 0;
 
-    if (ui->checkBoxKKTCUyruklu->isChecked()) {
-        kontenjanQueries.append("KKTCUyruklu = TRUE"); //In order to add OR Query, it is appended to kontenjanQueries
-    }
-    else {
-        whereQueries.append("KKTCUyruklu = FALSE"); //In order to add AND Query, it is appended to whereQueries
-    }
+    // The header may have been clicked while the query was running
+    const ProgramFilter current = currentProgramFilter();
+    programTableModel->sort(current.sortColumn, current.sortOrder);
 
-    if (ui->checkBoxMTOK->isChecked()) {
-        kontenjanQueries.append("MTOK = TRUE"); //In order to add OR Query, it is appended to kontenjanQueries
-    }
-    else {
-        whereQueries.append("MTOK = FALSE"); //In order to add AND Query, it is appended to whereQueries
+    // The first page of an SQL result is not traced on its own, the complete result covers it
+    if (QueryTrace::isEnabled() && !result.firstPage) {
+        // Completed by eventFilter() once the table has painted the new rows
+        pendingQueryTrace = result.trace;
+        pendingQueryTrace.requestedUs = queryRequestedUs;
+        pendingQueryTrace.phases[QueryTrace::Model] = QueryTrace::spanSince(modelStartUs);
+        queryTracePaintPending = true;
+        ui->tableViewPrograms->viewport()->update();
     }
 
-    if(!kontenjanQueries.isEmpty()) {
-        kontenjanSubQuery += "(" + kontenjanQueries[0];
-        for(int i = 1; i < kontenjanQueries.size(); i++) {
-            kontenjanSubQuery += " OR " + kontenjanQueries[i];
-        }
-        kontenjanSubQuery += ")";
+    if (StartupTimeline::elapsedMs(StartupTimeline::Interactive) < 0) {
+        StartupTimeline::mark(StartupTimeline::Interactive);
+        StartupTimeline::report();
     }
+}
 
-    if(!kontenjanSubQuery.isEmpty()) {
-        whereQueries.append(kontenjanSubQuery);
-    }
+ProgramFilter MainWindow::currentProgramFilter() const {
+    ProgramFilter filter;
+    filter.tercihTuru = tercihTuru;
+    filter.universityName = turkishLocale.toUpper(ui->comboBoxUniversity->currentText());
+    filter.department = ui->comboBoxDepartment->currentText();
 
-    if(!tuitionQueries.isEmpty()) {
-        tuitionSubQuery += "(" + tuitionQueries[0];
-        for(int i = 1; i < tuitionQueries.size(); i++) {
-            tuitionSubQuery += " OR " + tuitionQueries[i];
-        }
-        tuitionSubQuery += ")";
-    }
+    filter.ulke = static_cast<Ulke>(ui->comboBoxUlke->currentIndex());
+    filter.lisansTuru = static_cast<LisansTuru>(ui->comboBoxLicenseType->currentIndex());
+    filter.universiteTuru = static_cast<UniversiteTuru>(ui->comboBoxUniversityType->currentIndex());
+    filter.puanTuru = static_cast<PuanTuru>(ui->comboBoxPuanTuru->currentIndex());
 
-    if(!tuitionSubQuery.isEmpty())
-        whereQueries.append(tuitionSubQuery);
+    filter.enKucukPuan = ui->doubleSpinBoxEnKucukPuan->value();
+    filter.enBuyukPuan = ui->doubleSpinBoxEnBuyukPuan->value();
 
-    if(kontenjanSubQuery.isEmpty() || tuitionSubQuery.isEmpty()) {
-        ui->tableWidgetPrograms->setRowCount(0);
-        ui->tableWidgetPrograms->setUpdatesEnabled(true);
-        ui->tableWidgetPrograms->setSortingEnabled(true);
-        return;
+    // A range the table cannot answer would hide every program
+    if (ui->spinBoxEnKucukBasariSirasi->isEnabled()) {
+        filter.enKucukBasariSirasi = ui->spinBoxEnKucukBasariSirasi->value();
+        filter.enBuyukBasariSirasi = ui->spinBoxEnBuyukBasariSirasi->value();
     }
 
-    // LASTLY (FINALLY) process "WHERE" queries
-    if(!whereQueries.isEmpty()) {
-        sqlQuery += " WHERE ";
-        sqlQuery += whereQueries[0];
-        for(int i = 1; i < whereQueries.size(); i++) {
-            sqlQuery += " AND " + whereQueries[i];
-        }
-    }
+    filter.genel = ui->checkBoxGenel->isChecked();
+    filter.okulBirincisi = ui->checkBoxOkulBirincisi->isChecked();
+    filter.sehitGaziYakini = ui->checkBoxSehitGaziYakini->isChecked();
+    filter.depremzede = ui->checkBoxDepremzede->isChecked();
+    filter.kadin34 = ui->checkBoxKadin34->isChecked();
+    filter.kktcUyruklu = ui->checkBoxKKTCUyruklu->isChecked();
+    filter.mtok = ui->checkBoxMTOK->isChecked();
 
-    if(lastSortCol == -1) {
-        const QString key = SQLiteUtil::trOrderExprFor("ProgramKodu");
-        sqlQuery += " ORDER BY ProgramKodu ASC";
-    }
-    else if(!ui->tableWidgetPrograms->isColumnHidden(lastSortCol)) {
-        QString col = getDbColumnNameFromProgramTableColumnIndex(lastSortCol);
-        const QString key = SQLiteUtil::trOrderExprFor(col);
-        sqlQuery += " ORDER BY " + key;
-        if(lastSortOrder == Qt::AscendingOrder)
-            sqlQuery += " ASC";
-        else
-            sqlQuery += " DESC";
-    }
+    filter.ucretsiz = ui->checkBoxUcretsiz->isChecked();
+    filter.indirimli = ui->checkBoxIndirimli->isChecked();
+    filter.ucretli = ui->checkBoxUcretli->isChecked();
 
-    if (query.exec(sqlQuery)) {
-        int row = 0;
-        while (query.next()) {
-            ui->tableWidgetPrograms->insertRow(row);
-            int id = query.value("ProgramKodu").toInt();
-            QString universityType = query.value("UniversiteTuru").toString();
-            QString universityName = query.value("UniversiteAdi").toString();
-            QString facultyName = query.value("FakulteYuksekokulAdi").toString();
-            QString programAdi = query.value("ProgramAdi").toString();
-            QString puanTuru = query.value("PuanTuru").toString();
-            QString genelKontenjan = query.value("GenelKontenjan").toString();
-            QString generalMinimumPoints = query.value("GenelEnKucukPuan").toString();
-
-            QString sehitGaziKontenjan = query.value("SehitGaziKontenjan").toString();
-            QString sehitGaziEnKucukPuan = query.value("SehitGaziEnKucukPuan").toString();
-
-            QString depremzedeKontenjan = query.value("DepremzedeKontenjan").toString();
-            QString depremzedeEnKucukPuan = query.value("DepremzedeEnKucukPuan").toString();
-
-            QString kadin34Kontenjan = query.value("Kadin34Kontenjan").toString();
-            QString kadin34EnKucukPuan = query.value("Kadin34EnKucukPuan").toString();
-
-            //Ek kontenjanda yok
-            if(tercihTuru == TercihTuru::NormalTercih) {
-                //Ek kontenjanda yok
-                QString okulBirincisiKontenjan = query.value("OkulBirincisiKontenjan").toString();
-                QString okulBirincisiEnKucukPuan = query.value("OkulBirincisiEnKucukPuan").toString();
-
-                QString okulBirincisiYerlesen = query.value("OkulBirincisiYerlesen").toString();
-                QString sehitGaziYerlesen = query.value("SehitGaziYerlesen").toString();
-                QString depremzedeYerlesen = query.value("DepremzedeYerlesen").toString();
-                QString kadin34Yerlesen = query.value("Kadin34Yerlesen").toString();
-
-                QString genelYerlesen = query.value("GenelYerlesen").toString();
-                QString generalMaximumPoints = query.value("GenelEnBuyukPuan").toString();
-
-                ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::GenelYerlesen, createTableWidgetItem(genelYerlesen, Qt::AlignHCenter));
-                ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::OkulBirincisiYerlesen, createTableWidgetItem(okulBirincisiYerlesen, Qt::AlignHCenter));
-                ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::SehitGaziYakiniYerlesen, createTableWidgetItem(sehitGaziYerlesen, Qt::AlignHCenter));
-                ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::DepremzedeYerlesen, createTableWidgetItem(depremzedeYerlesen, Qt::AlignHCenter));
-                ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::Kadin34PlusYerlesen, createTableWidgetItem(kadin34Yerlesen, Qt::AlignHCenter));
-
-                ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::OkulBirincisiKontenjan, createTableWidgetItem(okulBirincisiKontenjan, Qt::AlignHCenter));
-                ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::OkulBirincisiEnKucukPuan, createTableWidgetItem(okulBirincisiEnKucukPuan, Qt::AlignLeft));
-            }
-
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::ProgramKodu, createTableWidgetItem(QString::number(id), Qt::AlignLeft));
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::Universite, createTableWidgetItem(universityName, Qt::AlignLeft));
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::Kampus, createTableWidgetItem(facultyName, Qt::AlignLeft));
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::Program, createTableWidgetItem(programAdi, Qt::AlignLeft));
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::PuanTuru, createTableWidgetItem(puanTuru, Qt::AlignHCenter));
-
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::GenelKontenjan, createTableWidgetItem(genelKontenjan, Qt::AlignHCenter));
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::GenelEnKucukPuan, createTableWidgetItem(generalMinimumPoints, Qt::AlignLeft));
-
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::SehitGaziYakiniKontenjan, createTableWidgetItem(sehitGaziKontenjan, Qt::AlignHCenter));
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::SehitGaziYakiniEnKucukPuan, createTableWidgetItem(sehitGaziEnKucukPuan, Qt::AlignLeft));
-
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::DepremzedeKontenjan, createTableWidgetItem(depremzedeKontenjan, Qt::AlignHCenter));
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::DepremzedeEnKucukPuan, createTableWidgetItem(depremzedeEnKucukPuan, Qt::AlignLeft));
-
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::Kadin34PlusKontenjan, createTableWidgetItem(kadin34Kontenjan, Qt::AlignHCenter));
-            ui->tableWidgetPrograms->setItem(row, (int) ProgramTableColumns::Kadin34PlusEnKucukPuan, createTableWidgetItem(kadin34EnKucukPuan, Qt::AlignLeft));
-
-            row++;
-        }
+    // Sorting by a hidden column falls back to the default order
+    if(lastSortCol != -1 && !ui->tableViewPrograms->isColumnHidden(lastSortCol)) {
+        filter.sortColumn = lastSortCol;
+        filter.sortOrder = lastSortOrder;
     }
-
-    ui->tableWidgetPrograms->setUpdatesEnabled(true);
-    ui->tableWidgetPrograms->setSortingEnabled(true);
-
-    return;
+    return filter;
 }
 
 void MainWindow::hideUnnecessaryColumnsOnTheProgramTable() {
     if(ui->checkBoxGenel->isChecked() || ui->checkBoxKKTCUyruklu->isChecked() || ui->checkBoxMTOK->isChecked()) {
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::GenelKontenjan);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::GenelYerlesen);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::GenelEnKucukPuan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::GenelKontenjan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::GenelYerlesen);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::GenelEnKucukPuan);
     }
     else {
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::GenelKontenjan);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::GenelYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::GenelEnKucukPuan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::GenelKontenjan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::GenelYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::GenelEnKucukPuan);
     }
 
     if(ui->checkBoxOkulBirincisi->isChecked()) {
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::OkulBirincisiKontenjan);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::OkulBirincisiYerlesen);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::OkulBirincisiEnKucukPuan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::OkulBirincisiKontenjan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::OkulBirincisiYerlesen);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::OkulBirincisiEnKucukPuan);
     }
     else {
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiKontenjan);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiEnKucukPuan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiKontenjan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiEnKucukPuan);
     }
 
     if(ui->checkBoxSehitGaziYakini->isChecked()) {
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::SehitGaziYakiniKontenjan);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::SehitGaziYakiniYerlesen);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::SehitGaziYakiniEnKucukPuan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::SehitGaziYakiniKontenjan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::SehitGaziYakiniYerlesen);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::SehitGaziYakiniEnKucukPuan);
     }
     else {
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniKontenjan);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniEnKucukPuan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniKontenjan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniEnKucukPuan);
     }
 
 
     if(ui->checkBoxDepremzede->isChecked()) {
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::DepremzedeKontenjan);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::DepremzedeYerlesen);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::DepremzedeEnKucukPuan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::DepremzedeKontenjan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::DepremzedeYerlesen);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::DepremzedeEnKucukPuan);
     }
     else {
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::DepremzedeKontenjan);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::DepremzedeYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::DepremzedeEnKucukPuan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::DepremzedeKontenjan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::DepremzedeYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::DepremzedeEnKucukPuan);
     }
 
 
     if(ui->checkBoxKadin34->isChecked()) {
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::Kadin34PlusKontenjan);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::Kadin34PlusYerlesen);
-        ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::Kadin34PlusEnKucukPuan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::Kadin34PlusKontenjan);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::Kadin34PlusYerlesen);
+        ui->tableViewPrograms->showColumn((int) ProgramTableColumns::Kadin34PlusEnKucukPuan);
     }
     else {
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusKontenjan);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusEnKucukPuan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusKontenjan);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusEnKucukPuan);
     }
 
     //Ek kontenjanda yok
     if(tercihTuru == TercihTuru::NormalTercih) {
         if(ui->checkBoxGenel->isChecked())
-            ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::GenelYerlesen);
+            ui->tableViewPrograms->showColumn((int) ProgramTableColumns::GenelYerlesen);
         if(ui->checkBoxOkulBirincisi->isChecked())
-            ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::OkulBirincisiYerlesen);
+            ui->tableViewPrograms->showColumn((int) ProgramTableColumns::OkulBirincisiYerlesen);
         if(ui->checkBoxSehitGaziYakini->isChecked())
-            ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::SehitGaziYakiniYerlesen);
+            ui->tableViewPrograms->showColumn((int) ProgramTableColumns::SehitGaziYakiniYerlesen);
         if(ui->checkBoxDepremzede->isChecked())
-            ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::DepremzedeYerlesen);
+            ui->tableViewPrograms->showColumn((int) ProgramTableColumns::DepremzedeYerlesen);
         if(ui->checkBoxKadin34->isChecked())
-            ui->tableWidgetPrograms->showColumn((int) ProgramTableColumns::Kadin34PlusYerlesen);
+            ui->tableViewPrograms->showColumn((int) ProgramTableColumns::Kadin34PlusYerlesen);
     }
     else {
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::GenelYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::DepremzedeYerlesen);
-        ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusYerlesen);
-    }
-}
-
-void MainWindow::hideUnusedColumnsOnTheProgramTable() {
-    ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::GenelBasariSirasi);
-    ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiBasariSirasi);
-    ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniBasariSirasi);
-    ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::DepremzedeBasariSirasi);
-    ui->tableWidgetPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusBasariSirasi);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::GenelYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::OkulBirincisiYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::SehitGaziYakiniYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::DepremzedeYerlesen);
+        ui->tableViewPrograms->hideColumn((int) ProgramTableColumns::Kadin34PlusYerlesen);
+    }
+
+    // Başarı sırası comes with the loaded tables, ek tercih results do not have it
+    const bool hasBasariSirasi = programStore.hasBasariSirasi(tercihTuru);
+    ui->tableViewPrograms->setColumnHidden((int) ProgramTableColumns::GenelBasariSirasi,
+        !hasBasariSirasi || !(ui->checkBoxGenel->isChecked() || ui->checkBoxKKTCUyruklu->isChecked() || ui->checkBoxMTOK->isChecked()));
+    ui->tableViewPrograms->setColumnHidden((int) ProgramTableColumns::OkulBirincisiBasariSirasi,
+        !hasBasariSirasi || !ui->checkBoxOkulBirincisi->isChecked());
+    ui->tableViewPrograms->setColumnHidden((int) ProgramTableColumns::SehitGaziYakiniBasariSirasi,
+        !hasBasariSirasi || !ui->checkBoxSehitGaziYakini->isChecked());
+    ui->tableViewPrograms->setColumnHidden((int) ProgramTableColumns::DepremzedeBasariSirasi,
+        !hasBasariSirasi || !ui->checkBoxDepremzede->isChecked());
+    ui->tableViewPrograms->setColumnHidden((int) ProgramTableColumns::Kadin34PlusBasariSirasi,
+        !hasBasariSirasi || !ui->checkBoxKadin34->isChecked());
+    ui->spinBoxEnKucukBasariSirasi->setEnabled(hasBasariSirasi);
+    ui->spinBoxEnBuyukBasariSirasi->setEnabled(hasBasariSirasi);
+    ui->pushButtonClearBasariSirasi->setEnabled(hasBasariSirasi);
 }
 
 void MainWindow::initializeYKSTableColumnNames()
@@ -687,37 +545,7 @@ void MainWindow::setLogoDarkMode(bool isDarkMode) {
 }
 
 QString MainWindow::getDbColumnNameFromProgramTableColumnIndex(int columnIndex) {
-    switch (static_cast<ProgramTableColumns>(columnIndex)) {
-    case ProgramTableColumns::ProgramKodu:              return "ProgramKodu";
-    case ProgramTableColumns::Universite:               return "UniversiteAdi";
-    case ProgramTableColumns::Kampus:                   return "FakulteYuksekokulAdi";
-    case ProgramTableColumns::Program:                  return "ProgramAdi";
-    case ProgramTableColumns::PuanTuru:                 return "PuanTuru";
-    case ProgramTableColumns::GenelKontenjan:           return "GenelKontenjan";
-    case ProgramTableColumns::GenelYerlesen:            return "GenelYerlesen";
-    case ProgramTableColumns::GenelEnKucukPuan:         return "GenelEnKucukPuan";
-    case ProgramTableColumns::OkulBirincisiKontenjan:   return "OkulBirincisiKontenjan";
-    case ProgramTableColumns::OkulBirincisiYerlesen:    return "OkulBirincisiYerlesen";
-    case ProgramTableColumns::OkulBirincisiEnKucukPuan: return "OkulBirincisiEnKucukPuan";
-    case ProgramTableColumns::SehitGaziYakiniKontenjan: return "SehitGaziKontenjan";
-    case ProgramTableColumns::SehitGaziYakiniYerlesen:  return "SehitGaziYerlesen";
-    case ProgramTableColumns::SehitGaziYakiniEnKucukPuan:return "SehitGaziEnKucukPuan";
-    case ProgramTableColumns::DepremzedeKontenjan:      return "DepremzedeKontenjan";
-    case ProgramTableColumns::DepremzedeYerlesen:       return "DepremzedeYerlesen";
-    case ProgramTableColumns::DepremzedeEnKucukPuan:    return "DepremzedeEnKucukPuan";
-    case ProgramTableColumns::Kadin34PlusKontenjan:     return "Kadin34Kontenjan";
-    case ProgramTableColumns::Kadin34PlusYerlesen:      return "Kadin34Yerlesen";
-    case ProgramTableColumns::Kadin34PlusEnKucukPuan:   return "Kadin34EnKucukPuan";
-    default: return QString();
-    }
-
-}
-
-QTableWidgetItem *MainWindow::createTableWidgetItem(const QString &text, const Qt::Alignment &alignment)
-{
-    QTableWidgetItem *item = new QTableWidgetItem(text);
-    item->setTextAlignment(alignment);
-    return item;
+    return ProgramTable::dbColumnName(static_cast<ProgramTableColumns>(columnIndex));
 }
 
 void MainWindow::on_checkBoxGenel_toggled(bool checked)
@@ -839,8 +667,27 @@ void MainWindow::on_comboBoxTercihTuru_currentIndexChanged(int index)
 
 void MainWindow::on_pushButtonClearPuanAraligi_clicked()
 {
-    ui->doubleSpinBoxEnKucukPuan->setValue(100.0);
-    ui->doubleSpinBoxEnBuyukPuan->setValue(560.0);
+    ui->doubleSpinBoxEnKucukPuan->setValue(ProgramFilter::EnKucukPuanSiniri);
+    ui->doubleSpinBoxEnBuyukPuan->setValue(ProgramFilter::EnBuyukPuanSiniri);
+}
+
+
+void MainWindow::on_pushButtonClearBasariSirasi_clicked()
+{
+    ui->spinBoxEnKucukBasariSirasi->setValue(0);
+    ui->spinBoxEnBuyukBasariSirasi->setValue(0);
+}
+
+
+void MainWindow::on_spinBoxEnKucukBasariSirasi_valueChanged(int arg1)
+{
+    populateProgramTable();
+}
+
+
+void MainWindow::on_spinBoxEnBuyukBasariSirasi_valueChanged(int arg1)
+{
+    populateProgramTable();
 }
 
 
@@ -12,10 +12,19 @@ You should have received a copy of the GNU General Public License along with thi
 
 #include <QMainWindow>
 #include <QLocale>
-#include <QSqlDatabase>
+#include <QThread>
 #include "EnumDefinitions.hpp"
+#include "Core/ProgramFilter.hpp"
+#include "Core/ProgramStore.hpp"
+#include "Core/QueryTrace.hpp"
 #include <QHeaderView>
-#include <QTableWidgetItem>
+
+struct ProgramCatalog;
+class ProgramTableModel;
+class ProgramQueryScheduler;
+class ProgramHistory;
+class QLabel;
+struct ProgramQueryResult;
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -80,29 +89,58 @@ private slots:
 
     void on_doubleSpinBoxEnBuyukPuan_valueChanged(double arg1);
 
+    void on_pushButtonClearBasariSirasi_clicked();
+
+    void on_spinBoxEnKucukBasariSirasi_valueChanged(int arg1);
+
+    void on_spinBoxEnBuyukBasariSirasi_valueChanged(int arg1);
+
     void on_comboBoxPuanTuru_currentIndexChanged(int index);
 
+    void onProgramQueryResultReady(const ProgramQueryResult &result);
+
+    void onCatalogReady(const ProgramCatalog &catalog);
+
+    void onProgramTableDoubleClicked(const QModelIndex &index);
+
+    void toggleQueryTrace();
+
+    void exportQueryTrace();
+
 private:
     Ui::MainWindow *ui;
-    void initDB();
+    void startLoading();
+    void onStoreReady(ProgramStore store);
     void setProgramTableColumnWidths();
-    void populateUniversitiesComboBox();
-    void populateDepartmentsComboBox();
+    void populateUniversitiesComboBox(const ProgramCatalog &catalog);
+    void populateDepartmentsComboBox(const ProgramCatalog &catalog);
     void populateProgramTable();
+    ProgramFilter currentProgramFilter() const;
     void hideUnnecessaryColumnsOnTheProgramTable();
-    void hideUnusedColumnsOnTheProgramTable();
     void initializeYKSTableColumnNames();
     bool event(QEvent *e) override;
+    bool eventFilter(QObject *watched, QEvent *e) override;
     void setLogoDarkMode(bool isDarkMode);
     QString getDbColumnNameFromProgramTableColumnIndex(int columnIndex);
 
-    QTableWidgetItem* createTableWidgetItem(const QString &text, const Qt::Alignment &alignment = Qt::AlignLeft | Qt::AlignVCenter);
-
     QLocale turkishLocale;
     int lastSortCol = -1;
     Qt::SortOrder lastSortOrder = Qt::AscendingOrder;
     QHeaderView * programTableHorizontalHeader = nullptr;
+    ProgramTableModel * programTableModel = nullptr;
     QStringList yksTableColumnNames;
-    QSqlDatabase db;
+    QString databasePath;
+    bool databaseAvailable = false;
+    QThread startupThread;
+    ProgramStore programStore;
+    ProgramQueryScheduler * programQueryScheduler = nullptr;
+    ProgramHistory * programHistory = nullptr;
     TercihTuru tercihTuru = TercihTuru::NormalTercih;
+    QLabel * queryTraceLabel = nullptr;
+    // When the filter of the latest scheduled query changed
+    qint64 queryRequestedUs = -1;
+    QueryTrace::Record pendingQueryTrace;
+    bool queryTracePaintPending = false;
+    // Generation of the SQL result whose first page the table shows, 0 when none
+    quint64 shownFirstPageGeneration = 0;
 };
@@ -0,0 +1,223 @@
+/*
+ProgramTableModel class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "ProgramTableModel.hpp"
+#include <algorithm>
+#include "Core/ProgramQueryEngine.hpp"
+
+ProgramTableModel::ProgramTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+    // A zero interval timer fires once the pending events are processed
+    streamTimer.setInterval(0);
+    connect(&streamTimer, &QTimer::timeout, this, [this]() {
+        appendRows(ChunkRows);
+    });
+}
+
+int ProgramTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : shownRowCount;
+}
+
+int ProgramTableModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ProgramTableColumnCount;
+}
+
+QVariant ProgramTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || table == nullptr || index.row() >= shownRowCount)
+        return QVariant();
+
+    const auto column = static_cast<ProgramTableColumns>(index.column());
+
+    if (role == Qt::TextAlignmentRole) {
+        switch (column) {
+        case ProgramTableColumns::ProgramKodu:
+        case ProgramTableColumns::Universite:
+        case ProgramTableColumns::Kampus:
+        case ProgramTableColumns::Program:
+        case ProgramTableColumns::GenelEnKucukPuan:
+        case ProgramTableColumns::OkulBirincisiEnKucukPuan:
+        case ProgramTableColumns::SehitGaziYakiniEnKucukPuan:
+        case ProgramTableColumns::DepremzedeEnKucukPuan:
+        case ProgramTableColumns::Kadin34PlusEnKucukPuan:
+            return int(Qt::AlignLeft);
+        default:
+            return int(Qt::AlignHCenter);
+        }
+    }
+
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    return table->displayData(rowIds.at(index.row()), index.column());
+}
+
+QVariant ProgramTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (static_cast<ProgramTableColumns>(section)) {
+    case ProgramTableColumns::ProgramKodu:                return tr("Program Kodu");
+    case ProgramTableColumns::Universite:                 return tr("Üniversite");
+    case ProgramTableColumns::Kampus:                     return tr("Kampüs");
+    case ProgramTableColumns::Program:                    return tr("Program");
+    case ProgramTableColumns::PuanTuru:                   return tr("Puan Türü");
+    case ProgramTableColumns::GenelKontenjan:             return tr("Kontenjan");
+    case ProgramTableColumns::GenelYerlesen:              return tr("Yerleşen");
+    case ProgramTableColumns::GenelBasariSirasi:          return tr("Başarı Sırası");
+    case ProgramTableColumns::GenelEnKucukPuan:           return tr("En Küçük Puanı");
+    case ProgramTableColumns::OkulBirincisiKontenjan:     return tr("Okul Birincisi Kontenjan");
+    case ProgramTableColumns::OkulBirincisiYerlesen:      return tr("Okul Birincisi Yerleşen");
+    case ProgramTableColumns::OkulBirincisiBasariSirasi:  return tr("Okul Birincisi Başarı Sırası");
+    case ProgramTableColumns::OkulBirincisiEnKucukPuan:   return tr("Okul Birincisi En Küçük Puan");
+    case ProgramTableColumns::SehitGaziYakiniKontenjan:   return tr("Şehit / Gazi Yakını Kontenjan");
+    case ProgramTableColumns::SehitGaziYakiniYerlesen:    return tr("Şehit / Gazi Yakını Yerleşen");
+    case ProgramTableColumns::SehitGaziYakiniBasariSirasi:return tr("Şehit / Gazi Yakını Başarı Sırası");
+    case ProgramTableColumns::SehitGaziYakiniEnKucukPuan: return tr("Şehit / Gazi Yakını En Küçük Puanı");
+    case ProgramTableColumns::DepremzedeKontenjan:        return tr("Depremzede Kontenjan");
+    case ProgramTableColumns::DepremzedeYerlesen:         return tr("Depremzede Yerleşen");
+    case ProgramTableColumns::DepremzedeBasariSirasi:     return tr("Depremzede Başarı Sırası");
+    case ProgramTableColumns::DepremzedeEnKucukPuan:      return tr("Depremzede En Küçük Puan");
+    case ProgramTableColumns::Kadin34PlusKontenjan:       return tr("34+ Kadın Kontenjan");
+    case ProgramTableColumns::Kadin34PlusYerlesen:        return tr("34+ Kadın Yerleşen");
+    case ProgramTableColumns::Kadin34PlusBasariSirasi:    return tr("34+ Kadın Başarı Sırası");
+    case ProgramTableColumns::Kadin34PlusEnKucukPuan:     return tr("34+ Kadın En Küçük Puanı");
+    default: return QVariant();
+    }
+}
+
+void ProgramTableModel::sort(int column, Qt::SortOrder order) {
+    if (column < 0 || column >= ProgramTableColumnCount) {
+        column = -1;
+        order = Qt::AscendingOrder;
+    }
+    if (column == sortColumn && order == sortOrder)
+        return;
+    // Sorting moves rows between the shown and the pending ones
+    appendPendingRows();
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+    const QModelIndexList oldIndexes = persistentIndexList();
+    QVector<int> oldRowIds;
+    oldRowIds.reserve(oldIndexes.size());
+    for (const QModelIndex &index : oldIndexes)
+        oldRowIds.append(rowIds.at(index.row()));
+
+    if (column == sortColumn) {
+        // Only the direction changed
+        std::reverse(rowIds.begin(), rowIds.end());
+    }
+    else if (table != nullptr) {
+        // The store tables come with their ranks, the copy read from SQLite gets them on first use
+        if (table == &queryTable && column >= 0 && queryTable.sortRanks[column].isEmpty())
+            queryTable.sortRanks[column] = queryTable.computeSortRanks(column);
+        table->sortRows(rowIds, column, order);
+    }
+    sortColumn = column;
+    sortOrder = order;
+
+    // Keep the selection and the current index on the same programs
+    if (!oldIndexes.isEmpty()) {
+        QHash<int, int> rowOfRowId;
+        rowOfRowId.reserve(rowIds.size());
+        for (int row = 0; row < rowIds.size(); row++)
+            rowOfRowId.insert(rowIds.at(row), row);
+
+        QModelIndexList newIndexes;
+        newIndexes.reserve(oldIndexes.size());
+        for (int i = 0; i < oldIndexes.size(); i++)
+            newIndexes.append(index(rowOfRowId.value(oldRowIds.at(i)), oldIndexes.at(i).column()));
+        changePersistentIndexList(oldIndexes, newIndexes);
+    }
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void ProgramTableModel::clear() {
+    beginResetModel();
+    streamTimer.stop();
+    table = nullptr;
+    rowIds.clear();
+    shownRowCount = 0;
+    sortColumn = -1;
+    sortOrder = Qt::AscendingOrder;
+    endResetModel();
+}
+
+void ProgramTableModel::setRows(const ProgramTable *table, const QVector<int> &rowIds,
+                                int sortColumn, Qt::SortOrder sortOrder) {
+    beginResetModel();
+    this->table = table;
+    this->rowIds = rowIds;
+    this->sortColumn = sortColumn;
+    this->sortOrder = sortOrder;
+    startStreaming();
+    endResetModel();
+}
+
+void ProgramTableModel::setQueryRows(const ProgramTable &table, const QVector<int> &rowIds,
+                                     int sortColumn, Qt::SortOrder sortOrder) {
+    beginResetModel();
+    queryTable = table;
+    this->table = &queryTable;
+    this->rowIds = rowIds;
+    this->sortColumn = sortColumn;
+    this->sortOrder = sortOrder;
+    startStreaming();
+    endResetModel();
+}
+
+void ProgramTableModel::appendQueryRows(const ProgramTable &table, const QVector<int> &rowIds,
+                                        int sortColumn, Qt::SortOrder sortOrder) {
+    // The first page was re-sorted or replaced in the meantime
+    if (this->table != &queryTable || sortColumn != this->sortColumn || sortOrder != this->sortOrder
+        || rowIds.size() < shownRowCount) {
+        setQueryRows(table, rowIds, sortColumn, sortOrder);
+        return;
+    }
+
+    // The shown rows have the same values in the complete table
+    queryTable = table;
+    this->rowIds = rowIds;
+    if (streaming)
+        streamTimer.start();
+    else
+        appendPendingRows();
+}
+
+void ProgramTableModel::setStreaming(bool streaming) {
+    this->streaming = streaming;
+    if (!streaming)
+        appendPendingRows();
+}
+
+void ProgramTableModel::startStreaming() {
+    streamTimer.stop();
+    shownRowCount = int(rowIds.size());
+    // The first page is enough to fill the view, the rest follows in idle time
+    if (streaming && shownRowCount > ProgramQueryEngine::FirstPageRows) {
+        shownRowCount = ProgramQueryEngine::FirstPageRows;
+        streamTimer.start();
+    }
+}
+
+void ProgramTableModel::appendRows(int count) {
+    count = qMin(count, int(rowIds.size()) - shownRowCount);
+    if (count > 0) {
+        beginInsertRows(QModelIndex(), shownRowCount, shownRowCount + count - 1);
+        shownRowCount += count;
+        endInsertRows();
+    }
+    if (!hasPendingRows())
+        streamTimer.stop();
+}
+
+void ProgramTableModel::appendPendingRows() {
+    appendRows(int(rowIds.size()) - shownRowCount);
+}
@@ -0,0 +1,71 @@
+/*
+ProgramTableModel class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QTimer>
+#include <QVector>
+#include "EnumDefinitions.hpp"
+#include "Core/ProgramTable.hpp"
+
+// Program tablosu için sanal model. Satırlar bir ProgramTable içindeki satır
+// numaralarıdır, hücre metinleri yalnızca görünen hücreler için data()
+// içinde üretilir. Akış kipinde büyük sonuçların önce ilk sayfası gösterilir,
+// kalan satırlar olay döngüsü boşta kaldıkça parça parça eklenir.
+class ProgramTableModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    // Rows appended per idle turn of the event loop in streaming mode
+    static constexpr int ChunkRows = 1000;
+
+    explicit ProgramTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    // Re-sorts the loaded rows without a new query, a negative column means ProgramKodu order
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    void clear();
+    // The table is not owned and must outlive the rows shown from it.
+    // sortColumn and sortOrder describe the order rowIds are already in.
+    void setRows(const ProgramTable *table, const QVector<int> &rowIds,
+                 int sortColumn = -1, Qt::SortOrder sortOrder = Qt::AscendingOrder);
+    // Keeps a (implicitly shared) copy of a table read from SQLite
+    void setQueryRows(const ProgramTable &table, const QVector<int> &rowIds,
+                      int sortColumn = -1, Qt::SortOrder sortOrder = Qt::AscendingOrder);
+    // Completes the first page of an SQL result shown by setQueryRows(): table holds
+    // the same rows followed by the rest, the shown rows stay where they are
+    void appendQueryRows(const ProgramTable &table, const QVector<int> &rowIds,
+                         int sortColumn = -1, Qt::SortOrder sortOrder = Qt::AscendingOrder);
+
+    // Off by default, every row is then shown by the reset
+    void setStreaming(bool streaming);
+    bool hasPendingRows() const { return shownRowCount < rowIds.size(); }
+
+private:
+    void startStreaming();
+    void appendRows(int count);
+    void appendPendingRows();
+
+    // Used when the program store is not available
+    ProgramTable queryTable;
+    const ProgramTable *table = nullptr;
+    QVector<int> rowIds;
+    int sortColumn = -1;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+
+    bool streaming = false;
+    // rowIds before this index are visible to the views
+    int shownRowCount = 0;
+    QTimer streamTimer;
+};
@@ -0,0 +1,145 @@
+/*
+PlacementSimulator class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "PlacementSimulator.hpp"
+#include <cmath>
+
+namespace {
+
+// Score and rank columns of every KontenjanTuru
+constexpr std::array<ProgramTableColumns, KontenjanTuruCount> TabanPuanColumns = {
+    ProgramTableColumns::GenelEnKucukPuan,
+    ProgramTableColumns::OkulBirincisiEnKucukPuan,
+    ProgramTableColumns::SehitGaziYakiniEnKucukPuan,
+    ProgramTableColumns::DepremzedeEnKucukPuan,
+    ProgramTableColumns::Kadin34PlusEnKucukPuan
+};
+
+constexpr std::array<ProgramTableColumns, KontenjanTuruCount> BasariSirasiColumns = {
+    ProgramTableColumns::GenelBasariSirasi,
+    ProgramTableColumns::OkulBirincisiBasariSirasi,
+    ProgramTableColumns::SehitGaziYakiniBasariSirasi,
+    ProgramTableColumns::DepremzedeBasariSirasi,
+    ProgramTableColumns::Kadin34PlusBasariSirasi
+};
+
+PuanTuru puanTuruOf(quint8 bits) {
+    switch (bits) {
+    case ProgramTable::PuanSAY: return PuanTuru::SAY;
+    case ProgramTable::PuanEA:  return PuanTuru::EA;
+    case ProgramTable::PuanSOZ: return PuanTuru::SOZ;
+    case ProgramTable::PuanTYT: return PuanTuru::TYT;
+    case ProgramTable::PuanDIL: return PuanTuru::DIL;
+    default: return PuanTuru::Tumu;
+    }
+}
+
+}
+
+PlacementSimulator::PlacementSimulator(const ProgramTable &table) {
+    programs.reserve(table.rowCount);
+    programIndex.reserve(table.rowCount);
+
+    for (int row = 0; row < table.rowCount; row++) {
+        ProgramCutoffs program;
+        program.programKodu = qint64(table.number(row, ProgramTableColumns::ProgramKodu));
+        program.puanTuru = puanTuruOf(table.puanTuru.at(row));
+        program.kontenjan = table.kontenjan.at(row);
+        program.kktcUyruklu = table.kktcUyruklu.at(row) == ProgramTable::BoolTrue;
+        program.mtok = table.mtok.at(row) == ProgramTable::BoolTrue;
+        for (int i = 0; i < KontenjanTuruCount; i++) {
+            program.tabanPuan[i] = float(table.number(row, TabanPuanColumns[i]));
+            program.basariSirasi[i] = float(table.number(row, BasariSirasiColumns[i]));
+        }
+        programIndex.insert(program.programKodu, int(programs.size()));
+        programs.append(program);
+    }
+}
+
+PlacementResult PlacementSimulator::simulate(const CandidateProfile &candidate) const {
+    PlacementResult result;
+    const int tercihSayisi = int(candidate.tercihler.size());
+    result.gecersizTercihSayisi = qMax(0, tercihSayisi - CandidateProfile::MaxTercihSayisi);
+
+    for (int tercih = 0; tercih < qMin(tercihSayisi, CandidateProfile::MaxTercihSayisi); tercih++) {
+        auto it = programIndex.constFind(candidate.tercihler.at(tercih));
+        if (it == programIndex.constEnd()) {
+            result.gecersizTercihSayisi++;
+            continue;
+        }
+        const ProgramCutoffs &program = programs.at(it.value());
+        const double puan = candidate.puan(program.puanTuru);
+        if (program.puanTuru == PuanTuru::Tumu || std::isnan(puan)) {
+            result.gecersizTercihSayisi++;
+            continue;
+        }
+        const int adaySirasi = candidate.basariSirasi(program.puanTuru);
+
+        for (int i = 0; i < KontenjanTuruCount; i++) {
+            const auto kontenjanTuru = static_cast<KontenjanTuru>(i);
+            if (!(program.kontenjan & (1 << i)) || !isEligible(candidate, program, kontenjanTuru))
+                continue;
+
+            const float basariSirasi = program.basariSirasi[i];
+            const float tabanPuan = program.tabanPuan[i];
+            bool admitted;
+            double fark;
+            bool siralamaIle = false;
+            if (adaySirasi > 0 && !std::isnan(basariSirasi)) {
+                admitted = adaySirasi <= basariSirasi;
+                fark = double(basariSirasi) - adaySirasi;
+                siralamaIle = true;
+            }
+            else if (!std::isnan(tabanPuan)) {
+                admitted = puan >= tabanPuan;
+                fark = puan - tabanPuan;
+            }
+            else {
+                // Nobody was placed last year ("Dolmadı"), any candidate with a score gets in
+                admitted = true;
+                fark = std::numeric_limits<double>::infinity();
+            }
+
+            if (admitted) {
+                result.yerlesti = true;
+                result.tercihSirasi = tercih;
+                result.programKodu = program.programKodu;
+                result.kontenjanTuru = kontenjanTuru;
+                result.siralamaIle = siralamaIle;
+                result.fark = fark;
+                return result;
+            }
+        }
+    }
+    return result;
+}
+
+QVector<PlacementResult> PlacementSimulator::simulate(const QVector<CandidateProfile> &candidates) const {
+    QVector<PlacementResult> results;
+    results.reserve(candidates.size());
+    for (const CandidateProfile &candidate : candidates)
+        results.append(simulate(candidate));
+    return results;
+}
+
+bool PlacementSimulator::isEligible(const CandidateProfile &candidate, const ProgramCutoffs &program, KontenjanTuru kontenjanTuru) const {
+    // KKTC uyruklu and M.T.O.K programs only take their own candidates, through the general quota
+    if ((program.kktcUyruklu && !candidate.kktcUyruklu) || (program.mtok && !candidate.mtok))
+        return false;
+
+    switch (kontenjanTuru) {
+    case KontenjanTuru::Genel:           return candidate.genel || program.kktcUyruklu || program.mtok;
+    case KontenjanTuru::OkulBirincisi:   return candidate.okulBirincisi;
+    case KontenjanTuru::SehitGaziYakini: return candidate.sehitGaziYakini;
+    case KontenjanTuru::Depremzede:      return candidate.depremzede;
+    case KontenjanTuru::Kadin34:         return candidate.kadin34;
+    }
+    return false;
+}
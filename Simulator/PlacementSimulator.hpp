@@ -0,0 +1,110 @@
+/*
+PlacementSimulator class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QHash>
+#include <QVector>
+#include <array>
+#include <limits>
+#include "Core/ProgramTable.hpp"
+#include "EnumDefinitions.hpp"
+
+// Kontenjan türleri in the order a candidate is tried for a program
+enum class KontenjanTuru : int {
+    Genel = 0,
+    OkulBirincisi,
+    SehitGaziYakini,
+    Depremzede,
+    Kadin34
+};
+
+constexpr int KontenjanTuruCount = (int) KontenjanTuru::Kadin34 + 1;
+
+// Scores, eligibility and preference list of one candidate
+struct CandidateProfile {
+    static constexpr int MaxTercihSayisi = 24;
+
+    // Indexed by PuanTuru, PuanTuru::Tumu is unused. NaN: no score of that type.
+    std::array<double, 6> puanlar;
+    // Başarı sırası per PuanTuru, 0 when unknown. Compared instead of the
+    // score whenever the program has a başarı sırası of the same kontenjan türü.
+    std::array<int, 6> basariSiralari{};
+
+    bool genel = true;
+    bool okulBirincisi = false;
+    bool sehitGaziYakini = false;
+    bool depremzede = false;
+    bool kadin34 = false;
+    bool kktcUyruklu = false;
+    bool mtok = false;
+
+    // ProgramKodu of every tercih, most wanted first. Only the first MaxTercihSayisi count.
+    QVector<qint64> tercihler;
+
+    CandidateProfile() { puanlar.fill(std::numeric_limits<double>::quiet_NaN()); }
+
+    double puan(PuanTuru puanTuru) const { return puanlar[(int) puanTuru]; }
+    void setPuan(PuanTuru puanTuru, double value) { puanlar[(int) puanTuru] = value; }
+    int basariSirasi(PuanTuru puanTuru) const { return basariSiralari[(int) puanTuru]; }
+    void setBasariSirasi(PuanTuru puanTuru, int value) { basariSiralari[(int) puanTuru] = value; }
+};
+
+struct PlacementResult {
+    bool yerlesti = false;
+    // Index into CandidateProfile::tercihler, -1 when not placed
+    int tercihSirasi = -1;
+    qint64 programKodu = 0;
+    KontenjanTuru kontenjanTuru = KontenjanTuru::Genel;
+    // true: placed by başarı sırası, false: by score
+    bool siralamaIle = false;
+    // Distance to last year's cutoff, larger is safer: başarı sırası of the
+    // program minus the candidate's, or the candidate's score minus the taban
+    // puan. Infinity when the kontenjan was not filled last year.
+    double fark = std::numeric_limits<double>::quiet_NaN();
+    // Tercihler that could not be evaluated: unknown program codes, tercihler
+    // after the 24th and programs of a PuanTuru the candidate has no score of
+    int gecersizTercihSayisi = 0;
+};
+
+// Probable placement of candidates against last year's cutoffs. The tercihler
+// are tried in order and the candidate is placed at the first program where one
+// of the kontenjan türleri they are eligible for admits them, the way ÖSYM
+// places a candidate at the highest preference their score reaches.
+// The cutoffs are copied out of a YKS ProgramTable into a compact array at
+// construction; simulate() only reads it and may run on several threads at once.
+class PlacementSimulator
+{
+public:
+    explicit PlacementSimulator(const ProgramTable &table);
+
+    int programCount() const { return int(programs.size()); }
+
+    PlacementResult simulate(const CandidateProfile &candidate) const;
+    QVector<PlacementResult> simulate(const QVector<CandidateProfile> &candidates) const;
+
+private:
+    struct ProgramCutoffs {
+        qint64 programKodu = 0;
+        PuanTuru puanTuru = PuanTuru::Tumu;
+        // ProgramTable::KontenjanBits of the kontenjan türleri the program has
+        quint8 kontenjan = 0;
+        bool kktcUyruklu = false;
+        bool mtok = false;
+        // Per KontenjanTuru, NaN when empty
+        std::array<float, KontenjanTuruCount> tabanPuan;
+        std::array<float, KontenjanTuruCount> basariSirasi;
+    };
+
+    bool isEligible(const CandidateProfile &candidate, const ProgramCutoffs &program, KontenjanTuru kontenjanTuru) const;
+
+    QVector<ProgramCutoffs> programs;
+    QHash<qint64, int> programIndex;
+};
@@ -0,0 +1,465 @@
+/*
+BatchCounselor class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BatchCounselor.hpp"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QSqlError>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <cmath>
+#include <limits>
+#include "Core/EkYerlestirmeParser.hpp"
+#include "Core/TrigramIndex.hpp"
+#include "Core/TsvReader.hpp"
+#include "Utils/SQLiteUtil.hpp"
+
+namespace {
+
+enum class StudentColumn {
+    Ogrenci,
+    Puan,
+    PuanAraligi,
+    Genel,
+    OkulBirincisi,
+    SehitGaziYakini,
+    Depremzede,
+    Kadin34,
+    KKTCUyruklu,
+    MTOK,
+    Ucretsiz,
+    Indirimli,
+    Ucretli,
+    Ulke,
+    LisansTuru,
+    UniversiteTuru,
+    UniversiteAdi,
+    ProgramAdi
+};
+
+struct HeaderColumn {
+    StudentColumn column;
+    PuanTuru puanTuru = PuanTuru::Tumu;
+};
+
+// Header names and values are compared without case, Turkish letters and separators
+QString foldKey(const QString &text) {
+    static const QHash<QChar, QChar> ascii = {
+        {QChar(0x131), 'i'}, {QChar(0x15F), 's'}, {QChar(0x11F), 'g'},
+        {QChar(0xFC), 'u'}, {QChar(0xF6), 'o'}, {QChar(0xE7), 'c'}
+    };
+    QString key;
+    const QString folded = TrigramIndex::turkishFold(text);
+    key.reserve(folded.size());
+    for (const QChar c : folded) {
+        if (c.isLetterOrNumber())
+            key.append(ascii.value(c, c));
+    }
+    return key;
+}
+
+bool headerColumn(const QString &name, HeaderColumn &header) {
+    static const QHash<QString, HeaderColumn> columns = {
+        {"ogrenci", {StudentColumn::Ogrenci}},
+        {"adsoyad", {StudentColumn::Ogrenci}},
+        {"ad", {StudentColumn::Ogrenci}},
+        {"numara", {StudentColumn::Ogrenci}},
+        {"no", {StudentColumn::Ogrenci}},
+        {"say", {StudentColumn::Puan, PuanTuru::SAY}},
+        {"ea", {StudentColumn::Puan, PuanTuru::EA}},
+        {"soz", {StudentColumn::Puan, PuanTuru::SOZ}},
+        {"tyt", {StudentColumn::Puan, PuanTuru::TYT}},
+        {"dil", {StudentColumn::Puan, PuanTuru::DIL}},
+        {"aralik", {StudentColumn::PuanAraligi}},
+        {"puanaraligi", {StudentColumn::PuanAraligi}},
+        {"genel", {StudentColumn::Genel}},
+        {"okulbirincisi", {StudentColumn::OkulBirincisi}},
+        {"sehitgazi", {StudentColumn::SehitGaziYakini}},
+        {"sehitgaziyakini", {StudentColumn::SehitGaziYakini}},
+        {"depremzede", {StudentColumn::Depremzede}},
+        {"kadin34", {StudentColumn::Kadin34}},
+        {"kktc", {StudentColumn::KKTCUyruklu}},
+        {"kktcuyruklu", {StudentColumn::KKTCUyruklu}},
+        {"mtok", {StudentColumn::MTOK}},
+        {"ucretsiz", {StudentColumn::Ucretsiz}},
+        {"indirimli", {StudentColumn::Indirimli}},
+        {"ucretli", {StudentColumn::Ucretli}},
+        {"ulke", {StudentColumn::Ulke}},
+        {"lisans", {StudentColumn::LisansTuru}},
+        {"lisansturu", {StudentColumn::LisansTuru}},
+        {"universiteturu", {StudentColumn::UniversiteTuru}},
+        {"universite", {StudentColumn::UniversiteAdi}},
+        {"universiteadi", {StudentColumn::UniversiteAdi}},
+        {"program", {StudentColumn::ProgramAdi}},
+        {"programadi", {StudentColumn::ProgramAdi}}
+    };
+
+    QString key = foldKey(name);
+    // "SAY Puanı" is the same column as "SAY"
+    if (key.size() > 4 && key.endsWith("puani"))
+        key.chop(5);
+    else if (key.size() > 4 && key.endsWith("puan"))
+        key.chop(4);
+    const auto it = columns.constFind(key);
+    if (it == columns.constEnd())
+        return false;
+    header = it.value();
+    return true;
+}
+
+// An empty cell keeps the default value
+bool parseFlag(const QString &text, bool &value) {
+    static const QStringList yes = {"1", "e", "evet", "x", "var", "true"};
+    static const QStringList no = {"0", "h", "hayir", "yok", "false"};
+    const QString key = foldKey(text);
+    if (key.isEmpty())
+        return true;
+    if (yes.contains(key))
+        value = true;
+    else if (no.contains(key))
+        value = false;
+    else
+        return false;
+    return true;
+}
+
+// Matches the item texts of the filter combo boxes, "Tümü" or an empty cell lists every program
+template <typename Enum>
+bool parseChoice(const QString &text, const QList<QPair<QString, Enum>> &choices, Enum &value) {
+    const QString key = foldKey(text);
+    if (key.isEmpty() || key == QLatin1String("tumu")) {
+        value = Enum::Tumu;
+        return true;
+    }
+    for (const auto &choice : choices) {
+        if (key == choice.first) {
+            value = choice.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseCell(const TsvField &field, const HeaderColumn &header, StudentProfile &student) {
+    ProgramFilter &filter = student.filter;
+    const QString text = field.text();
+    switch (header.column) {
+    case StudentColumn::Ogrenci:
+        student.ogrenci = text;
+        return true;
+    case StudentColumn::Puan: {
+        if (text.isEmpty())
+            return true;
+        double puan = 0;
+        if (!EkYerlestirmeParser::parseNumber(field, puan) || puan <= 0)
+            return false;
+        student.puanlar[int(header.puanTuru)] = puan;
+        return true;
+    }
+    case StudentColumn::PuanAraligi:
+        return text.isEmpty() || (EkYerlestirmeParser::parseNumber(field, student.puanAraligi) && student.puanAraligi >= 0);
+    case StudentColumn::Genel: return parseFlag(text, filter.genel);
+    case StudentColumn::OkulBirincisi: return parseFlag(text, filter.okulBirincisi);
+    case StudentColumn::SehitGaziYakini: return parseFlag(text, filter.sehitGaziYakini);
+    case StudentColumn::Depremzede: return parseFlag(text, filter.depremzede);
+    case StudentColumn::Kadin34: return parseFlag(text, filter.kadin34);
+    case StudentColumn::KKTCUyruklu: return parseFlag(text, filter.kktcUyruklu);
+    case StudentColumn::MTOK: return parseFlag(text, filter.mtok);
+    case StudentColumn::Ucretsiz: return parseFlag(text, filter.ucretsiz);
+    case StudentColumn::Indirimli: return parseFlag(text, filter.indirimli);
+    case StudentColumn::Ucretli: return parseFlag(text, filter.ucretli);
+    case StudentColumn::Ulke:
+        return parseChoice<Ulke>(text, {{"turkiye", Ulke::Turkiye}, {"kktc", Ulke::KKTC}, {"yurtdisi", Ulke::Yurtdisi}}, filter.ulke);
+    case StudentColumn::LisansTuru:
+        return parseChoice<LisansTuru>(text, {{"lisans", LisansTuru::Lisans}, {"onlisans", LisansTuru::Onlisans}}, filter.lisansTuru);
+    case StudentColumn::UniversiteTuru:
+        return parseChoice<UniversiteTuru>(text, {{"devlet", UniversiteTuru::Devlet}, {"vakif", UniversiteTuru::Vakif}}, filter.universiteTuru);
+    case StudentColumn::UniversiteAdi:
+        filter.universityName = text;
+        return true;
+    case StudentColumn::ProgramAdi:
+        filter.department = text;
+        return true;
+    }
+    return false;
+}
+
+// Kontenjan, başarı sırası and taban puanı of every kontenjan türü a student can be placed with
+QList<ProgramTableColumns> outputColumns(const ProgramTable &table, const ProgramFilter &filter) {
+    QList<ProgramTableColumns> columns = {
+        ProgramTableColumns::ProgramKodu,
+        ProgramTableColumns::Universite,
+        ProgramTableColumns::Kampus,
+        ProgramTableColumns::Program,
+        ProgramTableColumns::PuanTuru
+    };
+    const QList<QPair<bool, ProgramTableColumns>> groups = {
+        {filter.includesGenelScores(), ProgramTableColumns::GenelKontenjan},
+        {filter.okulBirincisi, ProgramTableColumns::OkulBirincisiKontenjan},
+        {filter.sehitGaziYakini, ProgramTableColumns::SehitGaziYakiniKontenjan},
+        {filter.depremzede, ProgramTableColumns::DepremzedeKontenjan},
+        {filter.kadin34, ProgramTableColumns::Kadin34PlusKontenjan}
+    };
+    for (const auto &group : groups) {
+        if (!group.first)
+            continue;
+        // Kontenjan, Yerleşen, BaşarıSırası, EnKüçükPuan follow each other
+        const int kontenjan = int(group.second);
+        for (int column : {kontenjan, kontenjan + 2, kontenjan + 3}) {
+            if (table.isColumnAvailable(static_cast<ProgramTableColumns>(column)))
+                columns.append(static_cast<ProgramTableColumns>(column));
+        }
+    }
+    return columns;
+}
+
+QString tsvCell(const QVariant &value) {
+    QString text = value.toString();
+    text.replace('\t', ' ').replace('\n', ' ').replace('\r', ' ');
+    return text;
+}
+
+class StudentTask : public QRunnable {
+public:
+    StudentTask(const ProgramStore *store, const StudentProfile *student, BatchCounselor::StudentResult *result)
+        : store(store), student(student), result(result) {}
+
+    void run() override {
+        // The store is only read, every task filters it at the same time
+        const QVector<int> rowIds = BatchCounselor::eligiblePrograms(*store, *student);
+        result->programCount = rowIds.size();
+        result->ok = BatchCounselor::writePrograms(result->path, store->table(student->filter.tercihTuru), *student, rowIds);
+    }
+
+private:
+    const ProgramStore *store;
+    const StudentProfile *student;
+    BatchCounselor::StudentResult *result;
+};
+
+}
+
+StudentProfile::StudentProfile() {
+    puanlar.fill(std::numeric_limits<double>::quiet_NaN());
+}
+
+bool StudentProfile::hasPuan(PuanTuru puanTuru) const {
+    return !std::isnan(puanlar[int(puanTuru)]);
+}
+
+BatchCounselor::BatchCounselor(const QString &databasePath, const QString &outputDirectory, TercihTuru tercihTuru, int threadCount)
+    : databasePath(databasePath)
+    , outputDirectory(outputDirectory)
+    , tercihTuru(tercihTuru)
+    , threadCount(threadCount > 0 ? threadCount : QThread::idealThreadCount())
+    , connectionName("BatchCounselor")
+{
+}
+
+BatchCounselor::~BatchCounselor() {
+    if (QSqlDatabase::contains(connectionName)) {
+        QSqlDatabase::database(connectionName, false).close();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+}
+
+bool BatchCounselor::run(const QString &studentsPath) {
+    QElapsedTimer timer;
+    timer.start();
+    QVector<StudentProfile> students;
+    if (!readStudents(studentsPath, tercihTuru, students))
+        return false;
+    if (students.isEmpty()) {
+        qCritical() << "Öğrenci listesi boş:" << studentsPath;
+        return false;
+    }
+    if (!QDir().mkpath(outputDirectory)) {
+        qCritical() << "Çıktı klasörü oluşturulamadı:" << outputDirectory;
+        return false;
+    }
+
+    // One snapshot of the tables for every student
+    if (!open() || !store.load(QSqlDatabase::database(connectionName, false))) {
+        qCritical() << "Program tabloları belleğe yüklenemedi:" << databasePath;
+        return false;
+    }
+    const qint64 loadMs = timer.elapsed();
+
+    timer.restart();
+    QVector<StudentResult> results(students.size());
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, qMin(threadCount, int(students.size()))));
+    for (int i = 0; i < students.size(); i++) {
+        results[i].path = outputPath(students.at(i), i);
+        pool.start(new StudentTask(&store, &students.at(i), &results[i]));
+    }
+    pool.waitForDone();
+    const qint64 counselMs = timer.elapsed();
+
+    bool ok = writeSummary(students, results);
+    int written = 0;
+    for (int i = 0; i < results.size(); i++) {
+        if (results.at(i).ok)
+            written++;
+        else
+            qCritical() << "Program listesi yazılamadı:" << results.at(i).path;
+    }
+    QTextStream(stdout) << written << "/" << students.size() << " öğrencinin program listesi yazıldı -> " << outputDirectory
+                        << ", yükleme " << loadMs << " ms, listeleme " << counselMs << " ms (" << pool.maxThreadCount()
+                        << " iş parçacığı)\n";
+    return ok && written == students.size();
+}
+
+bool BatchCounselor::readStudents(const QString &path, TercihTuru tercihTuru, QVector<StudentProfile> &students) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Öğrenci listesi açılamadı:" << path << file.errorString();
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    TsvReader reader(data.constData(), data.size(), TsvReader::detectSeparator(data.constData(), data.size()));
+
+    TsvRecord fields;
+    if (!reader.next(fields)) {
+        qCritical() << "Öğrenci listesinin başlık satırı yok:" << path;
+        return false;
+    }
+    // -1: the column is not read
+    QVector<int> headerIndexes;
+    QVector<HeaderColumn> headers;
+    bool hasPuan = false;
+    for (const TsvField &field : fields) {
+        HeaderColumn header;
+        if (headerColumn(field.text(), header)) {
+            headerIndexes.append(headers.size());
+            headers.append(header);
+            hasPuan = hasPuan || header.column == StudentColumn::Puan;
+        }
+        else {
+            headerIndexes.append(-1);
+            qDebug() << "Bilinmeyen sütun atlandı:" << field.text();
+        }
+    }
+    if (!hasPuan) {
+        qCritical() << "Öğrenci listesinde puan sütunu (SAY, EA, SÖZ, TYT, DİL) yok:" << path;
+        return false;
+    }
+
+    while (reader.next(fields)) {
+        if (fields.size() == 1 && fields.first().isEmpty())
+            continue;
+
+        StudentProfile student;
+        student.line = reader.line();
+        student.filter.tercihTuru = tercihTuru;
+        for (int i = 0; i < fields.size() && i < headerIndexes.size(); i++) {
+            if (headerIndexes.at(i) < 0)
+                continue;
+            if (!parseCell(fields.at(i), headers.at(headerIndexes.at(i)), student))
+                qDebug() << "Satır" << student.line << "geçersiz değer atlandı:" << fields.at(i).text();
+        }
+        if (student.ogrenci.isEmpty())
+            student.ogrenci = QString::number(students.size() + 1);
+        students.append(student);
+    }
+    return true;
+}
+
+QVector<ProgramFilter> BatchCounselor::filtersFor(const StudentProfile &student) {
+    QVector<ProgramFilter> filters;
+    for (PuanTuru puanTuru : {PuanTuru::SAY, PuanTuru::EA, PuanTuru::SOZ, PuanTuru::TYT, PuanTuru::DIL}) {
+        if (!student.hasPuan(puanTuru))
+            continue;
+        // The puan range of the application up to the puan: programs with a lower taban puanı
+        const double puan = student.puanlar[int(puanTuru)];
+        ProgramFilter filter = student.filter;
+        filter.puanTuru = puanTuru;
+        filter.enKucukPuan = ProgramFilter::EnKucukPuanSiniri;
+        filter.enBuyukPuan = qMin(puan + student.puanAraligi, ProgramFilter::EnBuyukPuanSiniri);
+        filter.sortColumn = int(ProgramTableColumns::GenelEnKucukPuan);
+        filter.sortOrder = Qt::DescendingOrder;
+        filters.append(filter);
+    }
+    return filters;
+}
+
+QVector<int> BatchCounselor::eligiblePrograms(const ProgramStore &store, const StudentProfile &student) {
+    // Every filter selects another puan türü, the results never overlap
+    QVector<int> rowIds;
+    for (const ProgramFilter &filter : filtersFor(student))
+        rowIds += store.filter(filter);
+    return rowIds;
+}
+
+bool BatchCounselor::writePrograms(const QString &path, const ProgramTable &table, const StudentProfile &student, const QVector<int> &rowIds) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    const QList<ProgramTableColumns> columns = outputColumns(table, student.filter);
+    QStringList cells;
+    for (ProgramTableColumns column : columns)
+        cells.append(ProgramTable::dbColumnName(column));
+    QByteArray data = cells.join('\t').toUtf8() + '\n';
+
+    for (int row : rowIds) {
+        cells.clear();
+        for (ProgramTableColumns column : columns)
+            cells.append(tsvCell(table.displayData(row, int(column))));
+        data += cells.join('\t').toUtf8() + '\n';
+    }
+    file.write(data);
+    return file.commit();
+}
+
+bool BatchCounselor::open() {
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    if (!SQLiteUtil::openDatabase(db, databasePath, SQLiteUtil::readOnlyOptions())) {
+        qCritical() << "Veritabanı açılamadı:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool BatchCounselor::writeSummary(const QVector<StudentProfile> &students, const QVector<StudentResult> &results) {
+    QSaveFile file(QDir(outputDirectory).filePath("Ozet.tsv"));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << "Özet dosyası yazılamadı:" << file.fileName();
+        return false;
+    }
+    QByteArray data = "Ogrenci\tSatir\tProgramSayisi\tDosya\n";
+    for (int i = 0; i < students.size(); i++) {
+        const QStringList cells = {
+            tsvCell(students.at(i).ogrenci),
+            QString::number(students.at(i).line),
+            QString::number(results.at(i).programCount),
+            QFileInfo(results.at(i).path).fileName()
+        };
+        data += cells.join('\t').toUtf8() + '\n';
+    }
+    file.write(data);
+    return file.commit();
+}
+
+QString BatchCounselor::outputPath(const StudentProfile &student, int index) const {
+    // The list position keeps the names unique, students may share a name
+    QString name;
+    for (const QChar c : student.ogrenci) {
+        name.append(c.isLetterOrNumber() || c == '-' ? c : QChar('_'));
+    }
+    return QDir(outputDirectory).filePath(QStringLiteral("%1_%2.tsv").arg(index + 1, 4, 10, QChar('0')).arg(name.left(64)));
+}
@@ -0,0 +1,78 @@
+/*
+BatchCounselor class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QVector>
+#include <array>
+#include "Core/ProgramFilter.hpp"
+#include "Core/ProgramStore.hpp"
+
+// One student of the counselor's list
+struct StudentProfile {
+    // Name or number of the student, also names the output file
+    QString ogrenci;
+    // Line of the student in the input file
+    int line = 0;
+    // Puan of every puan türü, indexed by PuanTuru, NaN when not given
+    std::array<double, 6> puanlar;
+    // Programs up to this many points above the puan are listed as well, 0 lists only reachable ones
+    double puanAraligi = 0;
+    // Every filter the student is listed with except puanTuru and the puan range
+    ProgramFilter filter;
+
+    StudentProfile();
+    bool hasPuan(PuanTuru puanTuru) const;
+};
+
+// Lists the programs every student of a CSV file can choose, with the filter
+// semantics of the program table of the application: one filter per puan
+// türü the student has a puan of, listing the programs whose taban puanı
+// is below it. The tables are loaded once and shared read-only by a thread
+// pool, each student is filtered by a pool task which writes its list to
+// its own file in the output directory as soon as it is done.
+class BatchCounselor
+{
+public:
+    // Result of one student task
+    struct StudentResult {
+        QString path;
+        int programCount = 0;
+        bool ok = false;
+    };
+
+    // threadCount <= 0 uses one thread per core
+    BatchCounselor(const QString &databasePath, const QString &outputDirectory, TercihTuru tercihTuru, int threadCount = 0);
+    ~BatchCounselor();
+
+    bool run(const QString &studentsPath);
+
+    // Reads the students of a tab, semicolon or comma separated file with a header line
+    static bool readStudents(const QString &path, TercihTuru tercihTuru, QVector<StudentProfile> &students);
+    // One filter per puan türü the student has a puan of, sorted by taban puanı
+    static QVector<ProgramFilter> filtersFor(const StudentProfile &student);
+    // Matching rows of store.table(tercihTuru), the rows of each puan türü in the order of filtersFor()
+    static QVector<int> eligiblePrograms(const ProgramStore &store, const StudentProfile &student);
+    static bool writePrograms(const QString &path, const ProgramTable &table, const StudentProfile &student, const QVector<int> &rowIds);
+
+private:
+    bool open();
+    bool writeSummary(const QVector<StudentProfile> &students, const QVector<StudentResult> &results);
+    QString outputPath(const StudentProfile &student, int index) const;
+
+    QString databasePath;
+    QString outputDirectory;
+    TercihTuru tercihTuru;
+    int threadCount;
+    QString connectionName;
+    ProgramStore store;
+};
@@ -0,0 +1,40 @@
+/*
+Main file of AcademyScope batch counselor
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BatchCounselor.hpp"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("AcademyScope batch counselor");
+    parser.addHelpOption();
+    parser.addPositionalArgument("database", "YKS.sqlite the programs are listed from, opened read-only");
+    parser.addPositionalArgument("students", "Tab, semicolon or comma separated student list with a header line, e.g. Ogrenci;SAY;EA;Ulke");
+    const QCommandLineOption outputOption({"o", "output"}, "Directory of the program lists, one file per student", "directory", "Tercihler");
+    const QCommandLineOption jobsOption({"j", "jobs"}, "Students listed at the same time, one per core by default", "count", "0");
+    const QCommandLineOption ekTercihOption({"e", "ek-tercih"}, "List the ek tercih programs instead of the YKS programs");
+    parser.addOption(outputOption);
+    parser.addOption(jobsOption);
+    parser.addOption(ekTercihOption);
+    parser.process(a);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 2)
+        parser.showHelp(2);
+
+    const TercihTuru tercihTuru = parser.isSet(ekTercihOption) ? TercihTuru::EkTercih : TercihTuru::NormalTercih;
+    BatchCounselor counselor(positional.at(0), parser.value(outputOption), tercihTuru, parser.value(jobsOption).toInt());
+    return counselor.run(positional.at(1)) ? 0 : 1;
+}
@@ -0,0 +1,534 @@
+/*
+BenchmarkRunner class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BenchmarkRunner.hpp"
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <algorithm>
+#include "Core/CatalogSnapshot.hpp"
+#include "Core/PreparedQueryCache.hpp"
+#include "Core/ProgramCatalog.hpp"
+#include "Core/ProgramQueryBuilder.hpp"
+#include "Core/ProgramTable.hpp"
+#include "Core/ResultCache.hpp"
+#include "ProgramTableModel.hpp"
+
+namespace {
+
+// Keeps the optimizer from dropping a result that is otherwise unused
+volatile int sink = 0;
+
+}
+
+BenchmarkRunner::BenchmarkRunner(const QString &databasePath, int iterations)
+    : databasePath(databasePath)
+    , connectionName("AcademyScopeBench")
+    , iterations(qMax(1, iterations))
+{
+}
+
+BenchmarkRunner::~BenchmarkRunner() {
+    db = QSqlDatabase();
+    if (QSqlDatabase::contains(connectionName))
+        QSqlDatabase::removeDatabase(connectionName);
+}
+
+bool BenchmarkRunner::run() {
+    resultList.clear();
+    counters = QJsonObject();
+
+    benchmarkStartup();
+    benchmarkOpenModes();
+    if (!openDatabase())
+        return false;
+
+    benchmarkCatalog();
+    if (!store.load(db)) {
+        qCritical() << "Program tabloları belleğe yüklenemedi";
+        return false;
+    }
+    benchmarkStoreFilters();
+    benchmarkSqlFilters();
+    benchmarkResultCache();
+    benchmarkSorting();
+    benchmarkModel();
+    benchmarkSimulator();
+    return true;
+}
+
+QJsonDocument BenchmarkRunner::results() const {
+    QJsonArray array;
+    for (const Result &result : resultList) {
+        QJsonObject object;
+        object["group"] = result.group;
+        object["name"] = result.name;
+        object["iterations"] = result.iterations;
+        object["minMs"] = result.minNs / 1e6;
+        object["medianMs"] = result.medianNs / 1e6;
+        object["meanMs"] = result.meanNs / 1e6;
+        if (result.rows >= 0)
+            object["rows"] = result.rows;
+        array.append(object);
+    }
+
+    QJsonObject root;
+    root["database"] = databasePath;
+    root["qtVersion"] = QString::fromLatin1(qVersion());
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["results"] = array;
+    root["counters"] = counters;
+    return QJsonDocument(root);
+}
+
+void BenchmarkRunner::measure(const QString &group, const QString &name, const std::function<int()> &body, int iterations) {
+    if (iterations < 0)
+        iterations = this->iterations;
+
+    // One untimed run warms up SQLite's page cache and Qt's lazy initializations
+    int rows = body();
+
+    QVector<qint64> times;
+    times.reserve(iterations);
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; i++) {
+        timer.start();
+        rows = body();
+        times.append(timer.nsecsElapsed());
+    }
+    sink = rows;
+
+    std::sort(times.begin(), times.end());
+    qint64 total = 0;
+    for (qint64 time : times)
+        total += time;
+
+    Result result;
+    result.group = group;
+    result.name = name;
+    result.iterations = iterations;
+    result.minNs = times.first();
+    result.medianNs = times.at(times.size() / 2);
+    result.meanNs = total / times.size();
+    result.rows = rows;
+    resultList.append(result);
+}
+
+bool BenchmarkRunner::openDatabase() {
+    db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    if (!SQLiteUtil::openDatabase(db, databasePath)) {
+        qCritical() << "Veritabanı açılamadı:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+void BenchmarkRunner::benchmarkStartup() {
+    const QString name = connectionName + "_Startup";
+    measure("startup", "open database", [this, &name]() {
+        int opened = 0;
+        {
+            QSqlDatabase startupDb = QSqlDatabase::addDatabase("QSQLITE", name);
+            opened = SQLiteUtil::openDatabase(startupDb, databasePath) ? 1 : 0;
+            // The first statement reads the schema
+            QSqlQuery query(startupDb);
+            query.exec("SELECT COUNT(*) FROM YKS");
+            startupDb.close();
+        }
+        QSqlDatabase::removeDatabase(name);
+        return opened;
+    });
+
+    measure("startup", "load program store", [this, &name]() {
+        int rows = 0;
+        {
+            QSqlDatabase startupDb = QSqlDatabase::addDatabase("QSQLITE", name);
+            SQLiteUtil::openDatabase(startupDb, databasePath);
+            ProgramStore startupStore;
+            if (startupStore.load(startupDb))
+                rows = startupStore.table(TercihTuru::NormalTercih).rowCount + startupStore.table(TercihTuru::EkTercih).rowCount;
+            startupDb.close();
+        }
+        QSqlDatabase::removeDatabase(name);
+        return rows;
+    }, qMin(iterations, 5));
+}
+
+void BenchmarkRunner::benchmarkOpenModes() {
+    // Every mode gets its own connections, a tuned connection must not warm up the next one
+    for (const auto &mode : openModes()) {
+        const QString group = "sqlite." + mode.first;
+        const SQLiteUtil::OpenOptions options = mode.second;
+        const QString name = connectionName + "_" + mode.first;
+
+        measure(group, "open database", [this, &name, &options]() {
+            int opened = 0;
+            {
+                QSqlDatabase modeDb = QSqlDatabase::addDatabase("QSQLITE", name);
+                opened = SQLiteUtil::openDatabase(modeDb, databasePath, options) ? 1 : 0;
+                QSqlQuery query(modeDb);
+                query.exec("SELECT COUNT(*) FROM YKS");
+                modeDb.close();
+            }
+            QSqlDatabase::removeDatabase(name);
+            return opened;
+        });
+
+        measure(group, "load program store", [this, &name, &options]() {
+            int rows = 0;
+            {
+                QSqlDatabase modeDb = QSqlDatabase::addDatabase("QSQLITE", name);
+                SQLiteUtil::openDatabase(modeDb, databasePath, options);
+                ProgramStore modeStore;
+                if (modeStore.load(modeDb))
+                    rows = modeStore.table(TercihTuru::NormalTercih).rowCount + modeStore.table(TercihTuru::EkTercih).rowCount;
+                modeDb.close();
+            }
+            QSqlDatabase::removeDatabase(name);
+            return rows;
+        }, qMin(iterations, 5));
+
+        // Query latencies over one long-lived connection, as in the query worker
+        {
+            QSqlDatabase modeDb = QSqlDatabase::addDatabase("QSQLITE", name);
+            if (SQLiteUtil::openDatabase(modeDb, databasePath, options)) {
+                const bool useSortKeyColumns = SQLiteUtil::hasSortKeyColumns(modeDb, "YKS");
+                PreparedQueryCache preparedQueries;
+                for (const auto &entry : filterMatrix()) {
+                    const ProgramFilter filter = entry.second;
+                    measure(group, "query " + entry.first, [&modeDb, &preparedQueries, filter, useSortKeyColumns]() {
+                        const ProgramQuery programQuery = ProgramQueryBuilder::compile(filter, useSortKeyColumns);
+                        QSqlQuery *query = preparedQueries.acquire(modeDb, programQuery.sql);
+                        if (query == nullptr)
+                            return -1;
+                        for (int i = 0; i < programQuery.bindings.size(); i++)
+                            query->bindValue(i, programQuery.bindings.at(i));
+                        int rows = 0;
+                        if (query->exec()) {
+                            while (query->next())
+                                rows++;
+                        }
+                        query->finish();
+                        return rows;
+                    });
+                }
+                preparedQueries.clear();
+                modeDb.close();
+            }
+        }
+        QSqlDatabase::removeDatabase(name);
+    }
+}
+
+void BenchmarkRunner::benchmarkCatalog() {
+    measure("catalog", "universities", [this]() {
+        return int(ProgramCatalog::loadUniversities(db).size());
+    });
+    measure("catalog", "departments", [this]() {
+        return int(ProgramCatalog::loadDepartments(db).size());
+    });
+
+    const QString snapshotPath = databasePath + ".catalog";
+    if (!CatalogSnapshot::write(snapshotPath, databasePath, ProgramCatalog::load(db)))
+        return;
+    measure("catalog", "snapshot read", [this, &snapshotPath]() {
+        ProgramCatalog catalog;
+        if (!CatalogSnapshot::read(snapshotPath, databasePath, catalog))
+            return -1;
+        return int(catalog.universities.size() + catalog.departments.size());
+    });
+    QFile::remove(snapshotPath);
+}
+
+void BenchmarkRunner::benchmarkStoreFilters() {
+    for (const auto &entry : filterMatrix()) {
+        const ProgramFilter filter = entry.second;
+        measure("filter.store", entry.first, [this, filter]() {
+            return int(store.filter(filter).size());
+        });
+    }
+}
+
+void BenchmarkRunner::benchmarkResultCache() {
+    // Flipping between two states, as with checkBoxGenel or comboBoxTercihTuru:
+    // after the first round every state is served from the cache
+    ProgramFilter withGenel;
+    ProgramFilter withoutGenel;
+    withoutGenel.genel = false;
+    withoutGenel.okulBirincisi = true;
+    ProgramFilter ekTercih;
+    ekTercih.tercihTuru = TercihTuru::EkTercih;
+    const QList<ProgramFilter> session = {withGenel, withoutGenel, withGenel, ekTercih, withGenel, withoutGenel};
+
+    ResultCache resultCache;
+    measure("cache", "toggle session", [this, &session, &resultCache]() {
+        int rows = 0;
+        for (const ProgramFilter &filter : session) {
+            QVector<int> rowIds;
+            if (!resultCache.find(filter, rowIds)) {
+                rowIds = store.filter(filter);
+                resultCache.insert(filter, rowIds);
+            }
+            rows += rowIds.size();
+        }
+        return rows;
+    });
+
+    QJsonObject cache;
+    cache["hits"] = resultCache.hits();
+    cache["misses"] = resultCache.misses();
+    cache["hitRate"] = resultCache.hitRate();
+    counters["resultCache"] = cache;
+}
+
+void BenchmarkRunner::benchmarkSimulator() {
+    const ProgramTable &table = store.table(TercihTuru::NormalTercih);
+    if (table.rowCount == 0)
+        return;
+
+    measure("simulator", "build cutoffs", [&table]() {
+        return PlacementSimulator(table).programCount();
+    });
+
+    // A class of synthetic candidates with 24 tercihler each, reproducible between runs
+    const QVector<CandidateProfile> candidates = syntheticCandidates(table, SimulatorCandidateCount);
+    const PlacementSimulator simulator(table);
+    measure("simulator", QStringLiteral("simulate %1 candidates").arg(candidates.size()), [&simulator, &candidates]() {
+        int placed = 0;
+        for (const PlacementResult &result : simulator.simulate(candidates))
+            placed += result.yerlesti;
+        return placed;
+    });
+}
+
+QVector<CandidateProfile> BenchmarkRunner::syntheticCandidates(const ProgramTable &table, int count) {
+    // Linear congruential generator, std::rand() differs between platforms
+    quint32 state = 12345;
+    const auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+
+    QVector<CandidateProfile> candidates;
+    candidates.reserve(count);
+    for (int i = 0; i < count; i++) {
+        CandidateProfile candidate;
+        for (PuanTuru puanTuru : {PuanTuru::SAY, PuanTuru::EA, PuanTuru::SOZ, PuanTuru::TYT, PuanTuru::DIL})
+            candidate.setPuan(puanTuru, 200.0 + next() % 36000 / 100.0);
+        candidate.okulBirincisi = next() % 20 == 0;
+        candidate.depremzede = next() % 10 == 0;
+        for (int tercih = 0; tercih < CandidateProfile::MaxTercihSayisi; tercih++) {
+            const int row = int(next() % quint32(table.rowCount));
+            candidate.tercihler.append(qint64(table.number(row, ProgramTableColumns::ProgramKodu)));
+        }
+        candidates.append(candidate);
+    }
+    return candidates;
+}
+
+void BenchmarkRunner::benchmarkSqlFilters() {
+    PreparedQueryCache preparedQueries;
+    for (const auto &entry : filterMatrix()) {
+        const ProgramFilter filter = entry.second;
+        measure("filter.sqlite", entry.first, [this, filter, &preparedQueries]() {
+            const ProgramQuery programQuery = ProgramQueryBuilder::compile(filter);
+            QSqlQuery *query = preparedQueries.acquire(db, programQuery.sql);
+            if (query == nullptr)
+                return -1;
+            for (int i = 0; i < programQuery.bindings.size(); i++)
+                query->bindValue(i, programQuery.bindings.at(i));
+
+            ProgramTable table;
+            table.tercihTuru = filter.tercihTuru;
+            if (query->exec())
+                table.appendFromQuery(*query);
+            query->finish();
+            return table.rowCount;
+        });
+    }
+    preparedQueries.clear();
+}
+
+void BenchmarkRunner::benchmarkSorting() {
+    const ProgramTable &table = store.table(TercihTuru::NormalTercih);
+    const QVector<int> rowIds = store.filter(ProgramFilter());
+
+    const QList<QPair<QString, ProgramTableColumns>> columns = {
+        {"Universite", ProgramTableColumns::Universite},
+        {"Program", ProgramTableColumns::Program},
+        {"GenelKontenjan", ProgramTableColumns::GenelKontenjan},
+        {"GenelEnKucukPuan", ProgramTableColumns::GenelEnKucukPuan}
+    };
+    for (const auto &column : columns) {
+        measure("sort", column.first + " ascending", [&table, &rowIds, &column]() {
+            QVector<int> sorted = rowIds;
+            table.sortRows(sorted, (int) column.second, Qt::AscendingOrder);
+            return int(sorted.size());
+        });
+        measure("sort", column.first + " ranks", [&table, &column]() {
+            return int(table.computeSortRanks((int) column.second).size());
+        }, qMin(iterations, 5));
+    }
+
+    ProgramTableModel model;
+    model.setRows(&table, rowIds);
+    measure("sort", "model header clicks", [&model]() {
+        model.sort((int) ProgramTableColumns::GenelEnKucukPuan, Qt::AscendingOrder);
+        model.sort((int) ProgramTableColumns::GenelEnKucukPuan, Qt::DescendingOrder);
+        model.sort((int) ProgramTableColumns::Universite, Qt::AscendingOrder);
+        model.sort(-1, Qt::AscendingOrder);
+        return model.rowCount();
+    });
+}
+
+void BenchmarkRunner::benchmarkModel() {
+    const ProgramTable &table = store.table(TercihTuru::NormalTercih);
+    const QVector<int> rowIds = store.filter(ProgramFilter());
+    ProgramTableModel model;
+
+    measure("model", "set rows", [&model, &table, &rowIds]() {
+        model.setRows(&table, rowIds);
+        return model.rowCount();
+    });
+
+    // What a view asks for when it paints one screen of the table
+    measure("model", "first page data", [&model]() {
+        int cells = 0;
+        const int rows = qMin(model.rowCount(), 50);
+        for (int row = 0; row < rows; row++) {
+            for (int column = 0; column < model.columnCount(); column++) {
+                const QModelIndex index = model.index(row, column);
+                cells += model.data(index, Qt::DisplayRole).isValid() ? 1 : 0;
+                cells += model.data(index, Qt::TextAlignmentRole).isValid() ? 1 : 0;
+            }
+        }
+        return cells;
+    });
+}
+
+QList<QPair<QString, SQLiteUtil::OpenOptions>> BenchmarkRunner::openModes() {
+    QList<QPair<QString, SQLiteUtil::OpenOptions>> modes;
+    modes.append({"writable", SQLiteUtil::writableOptions()});
+
+    // The read-only open alone, then every tuning on top of it
+    SQLiteUtil::OpenOptions options;
+    options.readOnly = true;
+    modes.append({"readOnly", options});
+
+    options.mmapSize = -1;
+    modes.append({"readOnly+mmap", options});
+
+    options.cacheSizeKiB = SQLiteUtil::readOnlyOptions().cacheSizeKiB;
+    modes.append({"readOnly+mmap+cache", options});
+
+    modes.append({"readOnly+mmap+cache+tempStore", SQLiteUtil::readOnlyOptions()});
+    return modes;
+}
+
+QList<QPair<QString, ProgramFilter>> BenchmarkRunner::filterMatrix() {
+    QList<QPair<QString, ProgramFilter>> filters;
+    filters.append({"default", ProgramFilter()});
+
+    const QList<QPair<QString, PuanTuru>> puanTurleri = {
+        {"SAY", PuanTuru::SAY}, {"EA", PuanTuru::EA}, {"SOZ", PuanTuru::SOZ},
+        {"TYT", PuanTuru::TYT}, {"DIL", PuanTuru::DIL}
+    };
+    for (const auto &puanTuru : puanTurleri) {
+        ProgramFilter filter;
+        filter.puanTuru = puanTuru.second;
+        filters.append({"puanTuru " + puanTuru.first, filter});
+    }
+
+    ProgramFilter filter;
+    filter.genel = false;
+    filter.okulBirincisi = true;
+    filters.append({"kontenjan okulBirincisi", filter});
+
+    filter = ProgramFilter();
+    filter.genel = false;
+    filter.sehitGaziYakini = true;
+    filter.depremzede = true;
+    filter.kadin34 = true;
+    filters.append({"kontenjan sehitGazi+depremzede+kadin34", filter});
+
+    filter = ProgramFilter();
+    filter.kktcUyruklu = true;
+    filter.mtok = true;
+    filters.append({"kontenjan genel+kktc+mtok", filter});
+
+    filter = ProgramFilter();
+    filter.indirimli = false;
+    filter.ucretli = false;
+    filters.append({"ucret ucretsiz", filter});
+
+    filter = ProgramFilter();
+    filter.ucretsiz = false;
+    filters.append({"ucret indirimli+ucretli", filter});
+
+    const QList<QPair<QString, Ulke>> ulkeler = {
+        {"Turkiye", Ulke::Turkiye}, {"KKTC", Ulke::KKTC}, {"Yurtdisi", Ulke::Yurtdisi}
+    };
+    for (const auto &ulke : ulkeler) {
+        filter = ProgramFilter();
+        filter.ulke = ulke.second;
+        filters.append({"ulke " + ulke.first, filter});
+    }
+
+    filter = ProgramFilter();
+    filter.enKucukPuan = 300;
+    filters.append({"puan 300+", filter});
+
+    filter = ProgramFilter();
+    filter.enKucukPuan = 350;
+    filter.enBuyukPuan = 450;
+    filter.okulBirincisi = true;
+    filters.append({"puan 350-450 genel+okulBirincisi", filter});
+
+    filter = ProgramFilter();
+    filter.puanTuru = PuanTuru::SAY;
+    filter.universiteTuru = UniversiteTuru::Devlet;
+    filter.lisansTuru = LisansTuru::Lisans;
+    filter.enKucukPuan = 400;
+    filters.append({"SAY devlet lisans 400+", filter});
+
+    filter = ProgramFilter();
+    filter.enKucukBasariSirasi = 10000;
+    filter.enBuyukBasariSirasi = 50000;
+    filters.append({"basari sirasi 10000-50000", filter});
+
+    filter = ProgramFilter();
+    filter.enBuyukBasariSirasi = 100000;
+    filter.okulBirincisi = true;
+    filter.depremzede = true;
+    filters.append({"basari sirasi 100000- genel+okulBirincisi+depremzede", filter});
+
+    filter = ProgramFilter();
+    filter.universityName = "İSTANBUL";
+    filters.append({"universite ISTANBUL", filter});
+
+    filter = ProgramFilter();
+    filter.department = "Bilgisayar";
+    filters.append({"program Bilgisayar", filter});
+
+    filter = ProgramFilter();
+    filter.sortColumn = (int) ProgramTableColumns::Universite;
+    filters.append({"default sorted by Universite", filter});
+
+    filter = ProgramFilter();
+    filter.tercihTuru = TercihTuru::EkTercih;
+    filters.append({"ek tercih default", filter});
+
+    return filters;
+}
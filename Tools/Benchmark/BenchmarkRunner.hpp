@@ -0,0 +1,78 @@
+/*
+BenchmarkRunner class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QPair>
+#include <QSqlDatabase>
+#include <QString>
+#include <functional>
+#include "Core/ProgramFilter.hpp"
+#include "Core/ProgramStore.hpp"
+#include "Simulator/PlacementSimulator.hpp"
+#include "Utils/SQLiteUtil.hpp"
+
+// Headless timing of the startup, catalog, filter, sort, model and simulator paths of the
+// application against a copy of YKS.sqlite. Every case is repeated and the
+// min / median / mean times are reported as JSON.
+class BenchmarkRunner
+{
+public:
+    static constexpr int DefaultIterations = 20;
+    static constexpr int SimulatorCandidateCount = 5000;
+
+    BenchmarkRunner(const QString &databasePath, int iterations = DefaultIterations);
+    ~BenchmarkRunner();
+
+    bool run();
+    QJsonDocument results() const;
+
+private:
+    struct Result {
+        QString group;
+        QString name;
+        int iterations = 0;
+        qint64 minNs = 0;
+        qint64 medianNs = 0;
+        qint64 meanNs = 0;
+        // Size of the measured result, e.g. the number of matching programs
+        int rows = -1;
+    };
+
+    // body returns the size of its result
+    void measure(const QString &group, const QString &name, const std::function<int()> &body, int iterations = -1);
+
+    bool openDatabase();
+    void benchmarkStartup();
+    void benchmarkOpenModes();
+    void benchmarkCatalog();
+    void benchmarkStoreFilters();
+    void benchmarkSqlFilters();
+    void benchmarkResultCache();
+    void benchmarkSorting();
+    void benchmarkModel();
+    void benchmarkSimulator();
+
+    static QList<QPair<QString, ProgramFilter>> filterMatrix();
+    static QList<QPair<QString, SQLiteUtil::OpenOptions>> openModes();
+    static QVector<CandidateProfile> syntheticCandidates(const ProgramTable &table, int count);
+
+    QString databasePath;
+    QString connectionName;
+    int iterations;
+    QSqlDatabase db;
+    ProgramStore store;
+    QList<Result> resultList;
+    // Non-timing figures such as cache hit rates
+    QJsonObject counters;
+};
@@ -0,0 +1,68 @@
+/*
+Main file of AcademyScope benchmark
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "BenchmarkRunner.hpp"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("AcademyScope benchmark");
+    parser.addHelpOption();
+    parser.addPositionalArgument("database", "YKS.sqlite to measure, a temporary copy of it is used");
+    const QCommandLineOption outputOption({"o", "output"}, "Write the JSON results to <file> instead of stdout", "file");
+    const QCommandLineOption iterationsOption({"n", "iterations"}, "Timed runs of each case", "count",
+                                              QString::number(BenchmarkRunner::DefaultIterations));
+    parser.addOption(outputOption);
+    parser.addOption(iterationsOption);
+    parser.process(a);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.isEmpty())
+        parser.showHelp(2);
+
+    // The measured database is never the one that ships
+    QTemporaryDir temporaryDir;
+    const QString databasePath = QDir(temporaryDir.path()).filePath("YKS.sqlite");
+    if (!temporaryDir.isValid() || !QFile::copy(positional.first(), databasePath)) {
+        QTextStream(stderr) << "Veritabanı kopyalanamadı: " << positional.first() << "\n";
+        return 1;
+    }
+
+    BenchmarkRunner runner(databasePath, parser.value(iterationsOption).toInt());
+    if (!runner.run())
+        return 1;
+
+    QJsonObject results = runner.results().object();
+    results["database"] = QFileInfo(positional.first()).absoluteFilePath();
+    const QByteArray json = QJsonDocument(results).toJson();
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            QTextStream(stderr) << "Sonuç dosyası açılamadı: " << file.fileName() << "\n";
+            return 1;
+        }
+        file.write(json);
+    }
+    else {
+        QTextStream(stdout) << json;
+    }
+    return 0;
+}
@@ -0,0 +1,357 @@
+/*
+DatabaseOptimizer class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "DatabaseOptimizer.hpp"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTextStream>
+#include "Core/ProgramFilter.hpp"
+#include "Core/ProgramQueryBuilder.hpp"
+#include "Utils/SQLiteUtil.hpp"
+#include "Utils/StringUtil.hpp"
+
+DatabaseOptimizer::DatabaseOptimizer(const QString &sourcePath, const QString &targetPath, const QString &reportPath)
+    : sourcePath(sourcePath)
+    , targetPath(targetPath)
+    , reportPath(reportPath)
+    , connectionName("DatabaseOptimizer")
+{
+}
+
+DatabaseOptimizer::~DatabaseOptimizer() {
+    if (QSqlDatabase::contains(connectionName)) {
+        QSqlDatabase::database(connectionName, false).close();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+}
+
+bool DatabaseOptimizer::run() {
+    if (!copyDatabase() || !open())
+        return false;
+
+    // page_size only changes with the next VACUUM and not in WAL mode
+    if (!execute("PRAGMA journal_mode = DELETE") ||
+        !execute(QStringLiteral("PRAGMA page_size = %1").arg(PageSize)))
+        return false;
+
+    for (const QString &table : {QStringLiteral("YKS"), QStringLiteral("EkTercihDetayli")}) {
+        if (!addSortKeyColumns(table) || !createIndexes(table))
+            return false;
+    }
+
+    if (!execute("ANALYZE") || !execute("VACUUM"))
+        return false;
+
+    return reportPath.isEmpty() || writeQueryPlanReport();
+}
+
+bool DatabaseOptimizer::runHistory() {
+    if (!copyDatabase() || !open())
+        return false;
+
+    for (const QString &table : {ProgramQueryBuilder::tableName(TercihTuru::NormalTercih),
+                                 ProgramQueryBuilder::tableName(TercihTuru::EkTercih)}) {
+        // Older years may lack the ek tercih table
+        const QStringList columns = tableColumns(table);
+        if (!columns.isEmpty() && !createIndex(table, columns, programKoduIndex(table)))
+            return false;
+    }
+    return true;
+}
+
+bool DatabaseOptimizer::copyDatabase() {
+    QDir().mkpath(QFileInfo(targetPath).absolutePath());
+    if (QFile::exists(targetPath) && !QFile::remove(targetPath)) {
+        qCritical() << "Eski veritabanı silinemedi:" << targetPath;
+        return false;
+    }
+    if (!QFile::copy(sourcePath, targetPath)) {
+        qCritical() << "Veritabanı kopyalanamadı:" << sourcePath << "->" << targetPath;
+        return false;
+    }
+    QFile::setPermissions(targetPath, QFile::permissions(targetPath) | QFileDevice::WriteOwner);
+    return true;
+}
+
+bool DatabaseOptimizer::open() {
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(targetPath);
+    if (!db.open()) {
+        qCritical() << "Veritabanı açılamadı:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseOptimizer::execute(const QString &sql) {
+    QSqlQuery query(QSqlDatabase::database(connectionName, false));
+    if (!query.exec(sql)) {
+        qCritical() << "Komut çalıştırılamadı:" << sql << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+QStringList DatabaseOptimizer::tableColumns(const QString &table) {
+    QStringList columns;
+    QSqlQuery query(QSqlDatabase::database(connectionName, false));
+    if (query.exec("PRAGMA table_info(" + table + ")")) {
+        while (query.next())
+            columns.append(query.value("name").toString());
+    }
+    return columns;
+}
+
+bool DatabaseOptimizer::addSortKeyColumns(const QString &table) {
+    const QStringList columns = tableColumns(table);
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+
+    for (const QString &column : SQLiteUtil::turkishSortedColumns()) {
+        const QString keyColumn = SQLiteUtil::sortKeyColumnFor(column);
+        if (!columns.contains(column) || columns.contains(keyColumn))
+            continue;
+
+        // Keys are computed here once instead of by nested REPLACE() calls on every sort.
+        // The rows are read first, the table is not updated while being scanned.
+        QList<QPair<QVariant, QVariant>> rows;
+        QSqlQuery select(db);
+        select.setForwardOnly(true);
+        if (!select.exec("SELECT rowid, " + column + " FROM " + table)) {
+            qCritical() << "Sütun okunamadı:" << column << select.lastError().text();
+            return false;
+        }
+        while (select.next())
+            rows.append({select.value(0), select.value(1)});
+        select.finish();
+
+        // The column and its keys are added together, a failed write leaves no NULL key column
+        // that hasSortKeyColumns() would take for a complete one
+        if (!db.transaction()) {
+            qCritical() << "İşlem başlatılamadı:" << db.lastError().text();
+            return false;
+        }
+        if (!execute("ALTER TABLE " + table + " ADD COLUMN " + keyColumn + " TEXT")) {
+            db.rollback();
+            return false;
+        }
+
+        QSqlQuery update(db);
+        if (!update.prepare("UPDATE " + table + " SET " + keyColumn + " = ? WHERE rowid = ?")) {
+            qCritical() << "Sıralama anahtarı komutu hazırlanamadı:" << keyColumn << update.lastError().text();
+            db.rollback();
+            return false;
+        }
+        for (const auto &row : rows) {
+            update.bindValue(0, row.second.isNull() ? QVariant() : QVariant(StringUtil::toTurkishSortKey(row.second.toString())));
+            update.bindValue(1, row.first);
+            if (!update.exec()) {
+                qCritical() << "Sıralama anahtarı yazılamadı:" << keyColumn << update.lastError().text();
+                update.finish();
+                db.rollback();
+                return false;
+            }
+        }
+        update.finish();
+        if (!db.commit()) {
+            qCritical() << "Sıralama anahtarları kaydedilemedi:" << keyColumn << db.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DatabaseOptimizer::createIndexes(const QString &table) {
+    const QStringList columns = tableColumns(table);
+    if (columns.isEmpty()) {
+        qWarning() << table << "tablosu bulunamadı, indeksler atlandı";
+        return true;
+    }
+
+    for (const IndexDefinition &index : indexDefinitions(table)) {
+        if (!createIndex(table, columns, index))
+            return false;
+    }
+    return true;
+}
+
+bool DatabaseOptimizer::createIndex(const QString &table, const QStringList &columns, const IndexDefinition &index) {
+    bool hasColumns = true;
+    for (const QString &column : index.columns + index.whereColumns)
+        hasColumns = hasColumns && columns.contains(column);
+    if (!hasColumns) {
+        qWarning() << index.name << "atlandı, tabloda gerekli sütunlar yok";
+        return true;
+    }
+
+    QString sql = "CREATE INDEX IF NOT EXISTS " + index.name + " ON " + table +
+                  " (" + index.columns.join(", ") + ")";
+    if (!index.where.isEmpty())
+        sql += " WHERE " + index.where;
+    return execute(sql);
+}
+
+QList<DatabaseOptimizer::IndexDefinition> DatabaseOptimizer::indexDefinitions(const QString &table) {
+    const QString prefix = "idx_" + table + "_";
+    QList<IndexDefinition> indexes;
+
+    // Default ORDER BY of every program query
+    indexes.append(programKoduIndex(table));
+
+    // Equality predicates that almost every query carries, most selective last.
+    // GenelEnKucukPuan and ProgramKodu make it covering for the default score range scan.
+    indexes.append({prefix + "Filtre",
+                    {"KKTCUyruklu", "MTOK", "PuanTuru", "UcretDurumu", "UlkeKodu",
+                     "DevletUniversitesi", "Lisans", "GenelEnKucukPuan", "ProgramKodu"},
+                    QString(), {}});
+
+    // One partial index per quota type, matching "<Kontenjan> IS NOT NULL AND <EnKucukPuan> > ?"
+    const QList<QPair<QString, QString>> quotaColumns = {
+        {"GenelKontenjan", "GenelEnKucukPuan"},
+        {"OkulBirincisiKontenjan", "OkulBirincisiEnKucukPuan"},
+        {"SehitGaziKontenjan", "SehitGaziEnKucukPuan"},
+        {"DepremzedeKontenjan", "DepremzedeEnKucukPuan"},
+        {"Kadin34Kontenjan", "Kadin34EnKucukPuan"}
+    };
+    for (const auto &quota : quotaColumns) {
+        indexes.append({prefix + quota.second, {quota.second, "ProgramKodu"},
+                        quota.first + " IS NOT NULL", {quota.first}});
+    }
+
+    // Başarı sırası ranges of the query fallback, "<BasariSirasi> >= ? AND <BasariSirasi> <= ?"
+    const QList<QPair<QString, QString>> rankColumns = {
+        {"GenelKontenjan", "GenelBasariSirasi"},
+        {"OkulBirincisiKontenjan", "OkulBirincisiBasariSirasi"},
+        {"SehitGaziKontenjan", "SehitGaziBasariSirasi"},
+        {"DepremzedeKontenjan", "DepremzedeBasariSirasi"},
+        {"Kadin34Kontenjan", "Kadin34BasariSirasi"}
+    };
+    for (const auto &rank : rankColumns) {
+        indexes.append({prefix + rank.second, {rank.second, "ProgramKodu"},
+                        rank.first + " IS NOT NULL", {rank.first}});
+    }
+
+    // KKTC uyruklu and M.T.O.K programs are few, and only queried when their box is checked
+    indexes.append({prefix + "KKTCUyruklu", {"GenelEnKucukPuan", "ProgramKodu"}, "KKTCUyruklu = TRUE", {"KKTCUyruklu"}});
+    indexes.append({prefix + "MTOK", {"GenelEnKucukPuan", "ProgramKodu"}, "MTOK = TRUE", {"MTOK"}});
+
+    // Header sorting of the text columns
+    for (const QString &column : SQLiteUtil::turkishSortedColumns()) {
+        const QString keyColumn = SQLiteUtil::sortKeyColumnFor(column);
+        indexes.append({prefix + keyColumn, {keyColumn}, QString(), {}});
+    }
+
+    return indexes;
+}
+
+DatabaseOptimizer::IndexDefinition DatabaseOptimizer::programKoduIndex(const QString &table) {
+    return {"idx_" + table + "_ProgramKodu", {"ProgramKodu"}, QString(), {}};
+}
+
+bool DatabaseOptimizer::writeQueryPlanReport() {
+    QFile file(reportPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qCritical() << "Rapor dosyası açılamadı:" << reportPath;
+        return false;
+    }
+    QTextStream out(&file);
+
+    // A representative set of filter combinations of the main window
+    QList<QPair<QString, ProgramFilter>> filters;
+    ProgramFilter filter;
+    filters.append({"Varsayılan", filter});
+
+    filter = ProgramFilter();
+    filter.puanTuru = PuanTuru::SAY;
+    filters.append({"Puan türü SAY", filter});
+
+    filter = ProgramFilter();
+    filter.puanTuru = PuanTuru::EA;
+    filter.universiteTuru = UniversiteTuru::Devlet;
+    filter.ucretli = false;
+    filter.indirimli = false;
+    filters.append({"EA, devlet, ücretsiz", filter});
+
+    filter = ProgramFilter();
+    filter.ulke = Ulke::KKTC;
+    filter.kktcUyruklu = true;
+    filters.append({"KKTC, KKTC uyruklu", filter});
+
+    filter = ProgramFilter();
+    filter.ulke = Ulke::Yurtdisi;
+    filter.lisansTuru = LisansTuru::Lisans;
+    filters.append({"Yurt dışı lisans", filter});
+
+    filter = ProgramFilter();
+    filter.enKucukPuan = 300;
+    filter.enBuyukPuan = 400;
+    filters.append({"Genel, 300-400 puan", filter});
+
+    filter = ProgramFilter();
+    filter.okulBirincisi = true;
+    filter.depremzede = true;
+    filter.enKucukPuan = 350;
+    filters.append({"Genel + okul birincisi + depremzede, 350+ puan", filter});
+
+    filter = ProgramFilter();
+    filter.genel = false;
+    filter.mtok = true;
+    filter.puanTuru = PuanTuru::TYT;
+    filters.append({"M.T.O.K, TYT", filter});
+
+    filter = ProgramFilter();
+    filter.enKucukBasariSirasi = 10000;
+    filter.enBuyukBasariSirasi = 50000;
+    filters.append({"Genel, 10000-50000 başarı sırası", filter});
+
+    filter = ProgramFilter();
+    filter.universityName = "İSTANBUL";
+    filters.append({"Üniversite adı araması", filter});
+
+    filter = ProgramFilter();
+    filter.department = "Bilgisayar";
+    filter.sortColumn = (int) ProgramTableColumns::GenelEnKucukPuan;
+    filter.sortOrder = Qt::DescendingOrder;
+    filters.append({"Program adı araması, puana göre azalan", filter});
+
+    filter = ProgramFilter();
+    filter.tercihTuru = TercihTuru::EkTercih;
+    filter.sortColumn = (int) ProgramTableColumns::Universite;
+    filters.append({"Ek tercih, üniversiteye göre", filter});
+
+    const QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+    for (const auto &entry : filters) {
+        const bool useSortKeyColumns = SQLiteUtil::hasSortKeyColumns(db, ProgramQueryBuilder::tableName(entry.second.tercihTuru));
+        const ProgramQuery programQuery = ProgramQueryBuilder::compile(entry.second, useSortKeyColumns);
+        out << "== " << entry.first << " ==\n";
+        out << programQuery.sql << "\n";
+
+        QSqlQuery query(db);
+        if (!query.prepare("EXPLAIN QUERY PLAN " + programQuery.sql)) {
+            out << "  (hazırlanamadı: " << query.lastError().text() << ")\n\n";
+            continue;
+        }
+        for (int i = 0; i < programQuery.bindings.size(); i++)
+            query.bindValue(i, programQuery.bindings.at(i));
+
+        if (!query.exec()) {
+            out << "  (çalıştırılamadı: " << query.lastError().text() << ")\n\n";
+            continue;
+        }
+        while (query.next())
+            out << "  " << query.value("detail").toString() << "\n";
+        out << "\n";
+    }
+    return true;
+}
@@ -0,0 +1,59 @@
+/*
+DatabaseOptimizer class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// Build step that turns the shipped YKS.sqlite into a read-optimized copy:
+// Turkish sort key columns, indexes matching ProgramQueryBuilder's predicates, ANALYZE statistics,
+// a larger page size and a VACUUM-ed file, plus a query plan report.
+// The partitions of earlier years (see Core/ProgramHistory.hpp) only get
+// the ProgramKodu index their lookups need, through runHistory().
+class DatabaseOptimizer
+{
+public:
+    static constexpr int PageSize = 8192;
+
+    DatabaseOptimizer(const QString &sourcePath, const QString &targetPath, const QString &reportPath);
+    ~DatabaseOptimizer();
+
+    bool run();
+    // Copy of a Gecmis/YKS_<yıl>.sqlite partition with the ProgramKodu index of every table
+    bool runHistory();
+
+private:
+    struct IndexDefinition {
+        QString name;
+        QStringList columns;
+        // Partial index condition, empty for a full index
+        QString where;
+        QStringList whereColumns;
+    };
+
+    bool copyDatabase();
+    bool open();
+    bool execute(const QString &sql);
+    QStringList tableColumns(const QString &table);
+    bool addSortKeyColumns(const QString &table);
+    bool createIndexes(const QString &table);
+    bool createIndex(const QString &table, const QStringList &columns, const IndexDefinition &index);
+    bool writeQueryPlanReport();
+
+    static QList<IndexDefinition> indexDefinitions(const QString &table);
+    static IndexDefinition programKoduIndex(const QString &table);
+
+    QString sourcePath;
+    QString targetPath;
+    QString reportPath;
+    QString connectionName;
+};
@@ -0,0 +1,32 @@
+/*
+Main file of AcademyScope database optimizer
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "DatabaseOptimizer.hpp"
+
+#include <QCoreApplication>
+#include <QTextStream>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QStringList arguments = a.arguments();
+    // --history: a partition of earlier years, only the ProgramKodu index is created
+    const bool history = arguments.removeAll(QStringLiteral("--history")) > 0;
+    if (arguments.size() < 3) {
+        QTextStream(stderr) << "Kullanım: " << arguments.value(0) << " <kaynak.sqlite> <hedef.sqlite> [sorgu_plani.txt]\n"
+                            << "          " << arguments.value(0) << " --history <Gecmis/YKS_yyyy.sqlite> <hedef.sqlite>\n";
+        return 2;
+    }
+
+    DatabaseOptimizer optimizer(arguments.at(1), arguments.at(2), arguments.value(3));
+    if (history)
+        return optimizer.runHistory() ? 0 : 1;
+    return optimizer.run() ? 0 : 1;
+}
@@ -0,0 +1,337 @@
+/*
+EkYerlestirmeImporter class definitions of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "EkYerlestirmeImporter.hpp"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QRunnable>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include "Core/ProgramDelta.hpp"
+#include "Core/ProgramQueryBuilder.hpp"
+#include "Utils/SQLiteUtil.hpp"
+#include "Utils/StringUtil.hpp"
+
+namespace {
+
+class ParseTask : public QRunnable {
+public:
+    explicit ParseTask(EkYerlestirmeImporter::ParsedFile *parsedFile) : parsedFile(parsedFile) {}
+
+    void run() override {
+        QElapsedTimer timer;
+        timer.start();
+        parsedFile->ok = EkYerlestirmeParser::parseFile(parsedFile->path, parsedFile->arena);
+        parsedFile->parseMs = timer.elapsed();
+    }
+
+private:
+    EkYerlestirmeImporter::ParsedFile *parsedFile;
+};
+
+// Columns the application reads that ek yerleştirme has no values for
+const QList<QPair<const char *, const char *>> &emptyColumns() {
+    static const QList<QPair<const char *, const char *>> columns = {
+        {"GenelYerlesen", "INTEGER"},
+        {"OkulBirincisiKontenjan", "INTEGER"},
+        {"OkulBirincisiYerlesen", "INTEGER"},
+        {"OkulBirincisiEnKucukPuan", "REAL"},
+        {"SehitGaziYerlesen", "INTEGER"},
+        {"DepremzedeYerlesen", "INTEGER"},
+        {"Kadin34Yerlesen", "INTEGER"}
+    };
+    return columns;
+}
+
+}
+
+EkYerlestirmeImporter::EkYerlestirmeImporter(const QString &databasePath, bool replaceTable, int threadCount)
+    : databasePath(databasePath)
+    , replaceTable(replaceTable)
+    , threadCount(threadCount > 0 ? threadCount : QThread::idealThreadCount())
+    , connectionName("EkYerlestirmeImporter")
+{
+}
+
+EkYerlestirmeImporter::~EkYerlestirmeImporter() {
+    if (QSqlDatabase::contains(connectionName)) {
+        QSqlDatabase::database(connectionName, false).close();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+}
+
+bool EkYerlestirmeImporter::run(const QStringList &files) {
+    QElapsedTimer timer;
+    timer.start();
+    QVector<EkYerlestirmeRow> rows;
+    if (!parse(files, rows))
+        return false;
+    const qint64 parseMs = timer.elapsed();
+
+    timer.restart();
+    if (!open() || !createTable() || !write(rows))
+        return false;
+    const qint64 writeMs = timer.elapsed();
+
+    QTextStream(stdout) << rows.size() << " program aktarıldı, okuma " << parseMs << " ms (" << threadCount
+                        << " iş parçacığı), yazma " << writeMs << " ms\n";
+    return true;
+}
+
+bool EkYerlestirmeImporter::writeDelta(const QStringList &files, const QString &deltaPath) {
+    QVector<EkYerlestirmeRow> rows;
+    if (!parse(files, rows) || !open())
+        return false;
+
+    QList<EkYerlestirmeParser::Column> columns;
+    QStringList names;
+    if (!importedColumns(columns, names))
+        return false;
+
+    QVector<QVariantList> values;
+    values.reserve(rows.size());
+    for (const EkYerlestirmeRow &row : rows) {
+        QVariantList rowValues;
+        rowValues.reserve(columns.size());
+        for (const EkYerlestirmeParser::Column &column : columns)
+            rowValues.append(column.value(row));
+        values.append(rowValues);
+    }
+
+    // Without --replace the release only adds or updates programs, like the import itself
+    ProgramDelta delta;
+    const QString table = ProgramQueryBuilder::tableName(TercihTuru::EkTercih);
+    if (!ProgramDeltaEngine::diff(QSqlDatabase::database(connectionName, false), table, names, values, delta))
+        return false;
+    if (!replaceTable)
+        delta.removedPrograms.clear();
+
+    if (!ProgramDeltaEngine::write(deltaPath, delta)) {
+        qCritical() << "Güncelleme dosyası yazılamadı:" << deltaPath;
+        return false;
+    }
+    QTextStream(stdout) << delta.insertedRows.size() << " yeni program, " << delta.removedPrograms.size()
+                        << " kaldırılan program, " << delta.changes.size() << " değişen alan -> " << deltaPath << "\n";
+    return true;
+}
+
+bool EkYerlestirmeImporter::applyDelta(const QString &deltaPath) {
+    ProgramDelta delta;
+    if (!ProgramDeltaEngine::read(deltaPath, delta)) {
+        qCritical() << "Güncelleme dosyası okunamadı:" << deltaPath;
+        return false;
+    }
+    if (!open() || !ProgramDeltaEngine::apply(QSqlDatabase::database(connectionName, false), delta))
+        return false;
+
+    QTextStream(stdout) << delta.insertedRows.size() << " yeni program, " << delta.removedPrograms.size()
+                        << " kaldırılan program, " << delta.changes.size() << " değişen alan uygulandı\n";
+    return true;
+}
+
+bool EkYerlestirmeImporter::parse(const QStringList &files, QVector<EkYerlestirmeRow> &rows) {
+    QVector<ParsedFile> parsedFiles(files.size());
+    for (int i = 0; i < files.size(); i++)
+        parsedFiles[i].path = files.at(i);
+    if (!parseFiles(parsedFiles))
+        return false;
+    rows = mergeArenas(parsedFiles);
+
+    QTextStream out(stdout);
+    for (const ParsedFile &parsedFile : parsedFiles) {
+        const EkYerlestirmeParser::Statistics &statistics = parsedFile.arena.statistics;
+        out << QFileInfo(parsedFile.path).fileName() << ": " << statistics.rows << " program, "
+            << statistics.skippedRecords << " satır atlandı, " << parsedFile.parseMs << " ms\n";
+    }
+    return true;
+}
+
+bool EkYerlestirmeImporter::parseFiles(QVector<ParsedFile> &parsedFiles) {
+    // Files are independent, every task owns its ParsedFile and nothing else is shared
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, qMin(threadCount, int(parsedFiles.size()))));
+    for (ParsedFile &parsedFile : parsedFiles)
+        pool.start(new ParseTask(&parsedFile));
+    pool.waitForDone();
+
+    for (const ParsedFile &parsedFile : parsedFiles) {
+        if (!parsedFile.ok) {
+            qCritical() << "Dosya okunamadı:" << parsedFile.path;
+            return false;
+        }
+    }
+    return true;
+}
+
+QVector<EkYerlestirmeRow> EkYerlestirmeImporter::mergeArenas(const QVector<ParsedFile> &parsedFiles) {
+    int rowCount = 0;
+    for (const ParsedFile &parsedFile : parsedFiles)
+        rowCount += parsedFile.arena.rows.size();
+
+    QVector<EkYerlestirmeRow> rows;
+    rows.reserve(rowCount);
+    QHash<qint64, int> rowOfProgram;
+    rowOfProgram.reserve(rowCount);
+
+    // In the order of the command line, so the later file wins, e.g. tablo3_25092025.csv over Tablo3.csv
+    for (const ParsedFile &parsedFile : parsedFiles) {
+        for (const EkYerlestirmeRow &row : parsedFile.arena.rows) {
+            auto it = rowOfProgram.find(row.programKodu);
+            if (it != rowOfProgram.end()) {
+                rows[it.value()] = row;
+            }
+            else {
+                rowOfProgram.insert(row.programKodu, rows.size());
+                rows.append(row);
+            }
+        }
+    }
+    return rows;
+}
+
+bool EkYerlestirmeImporter::open() {
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    if (!SQLiteUtil::openDatabase(db, databasePath, SQLiteUtil::writableOptions())) {
+        qCritical() << "Veritabanı açılamadı:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool EkYerlestirmeImporter::createTable() {
+    QStringList definitions;
+    for (const EkYerlestirmeParser::Column &column : EkYerlestirmeParser::columns())
+        definitions.append(QStringLiteral("%1 %2").arg(column.name, column.type));
+    for (const auto &column : emptyColumns())
+        definitions.append(QStringLiteral("%1 %2").arg(column.first, column.second));
+
+    QSqlQuery query(QSqlDatabase::database(connectionName, false));
+    return execute(query, "CREATE TABLE IF NOT EXISTS " + ProgramQueryBuilder::tableName(TercihTuru::EkTercih) +
+                          " (" + definitions.join(", ") + ")");
+}
+
+QStringList EkYerlestirmeImporter::tableColumns() {
+    QStringList columns;
+    QSqlQuery query(QSqlDatabase::database(connectionName, false));
+    if (query.exec("PRAGMA table_info(" + ProgramQueryBuilder::tableName(TercihTuru::EkTercih) + ")")) {
+        while (query.next())
+            columns.append(query.value("name").toString());
+    }
+    return columns;
+}
+
+bool EkYerlestirmeImporter::importedColumns(QList<EkYerlestirmeParser::Column> &columns, QStringList &names) {
+    // An existing table may have fewer columns, only those are filled
+    const QStringList existingColumns = tableColumns();
+    for (const EkYerlestirmeParser::Column &column : EkYerlestirmeParser::columns()) {
+        if (existingColumns.contains(QLatin1String(column.name))) {
+            columns.append(column);
+            names.append(QLatin1String(column.name));
+        }
+    }
+    if (!names.contains(QStringLiteral("ProgramKodu"))) {
+        qCritical() << ProgramQueryBuilder::tableName(TercihTuru::EkTercih) << "tablosunda ProgramKodu sütunu yok";
+        return false;
+    }
+    return true;
+}
+
+bool EkYerlestirmeImporter::write(const QVector<EkYerlestirmeRow> &rows) {
+    const QString table = ProgramQueryBuilder::tableName(TercihTuru::EkTercih);
+
+    QList<EkYerlestirmeParser::Column> bindings;
+    QStringList names;
+    if (!importedColumns(bindings, names))
+        return false;
+
+    // An optimized database keeps sort key columns, they follow their text columns like in ProgramDeltaEngine::apply
+    const QStringList existingColumns = tableColumns();
+    QList<int> sortKeyBindings;
+    for (int column = 0; column < bindings.size(); column++) {
+        const QString keyColumn = SQLiteUtil::sortKeyColumnFor(names.at(column));
+        if (SQLiteUtil::turkishSortedColumns().contains(names.at(column)) && existingColumns.contains(keyColumn)) {
+            sortKeyBindings.append(column);
+            names.append(keyColumn);
+        }
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+    if (!db.transaction()) {
+        qCritical() << "İşlem başlatılamadı:" << db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    bool ok = true;
+    if (replaceTable) {
+        ok = execute(query, "DELETE FROM " + table);
+    }
+    else {
+        // One DELETE for every imported program instead of a table scan per row
+        ok = execute(query, "CREATE TEMP TABLE IF NOT EXISTS AktarilanProgramlar (ProgramKodu INTEGER PRIMARY KEY)") &&
+             execute(query, "DELETE FROM temp.AktarilanProgramlar");
+        if (ok) {
+            QSqlQuery insertCode(db);
+            ok = insertCode.prepare("INSERT OR IGNORE INTO temp.AktarilanProgramlar VALUES (?)");
+            for (int i = 0; ok && i < rows.size(); i++) {
+                insertCode.bindValue(0, rows.at(i).programKodu);
+                ok = insertCode.exec();
+            }
+            if (!ok)
+                qCritical() << "Program kodları yazılamadı:" << insertCode.lastError().text();
+        }
+        ok = ok && execute(query, "DELETE FROM " + table +
+                                  " WHERE ProgramKodu IN (SELECT ProgramKodu FROM temp.AktarilanProgramlar)");
+    }
+
+    if (ok) {
+        QStringList placeholders;
+        for (int i = 0; i < names.size(); i++)
+            placeholders.append(QStringLiteral("?"));
+
+        QSqlQuery insert(db);
+        ok = insert.prepare("INSERT INTO " + table + " (" + names.join(", ") + ") VALUES (" + placeholders.join(", ") + ")");
+        for (int i = 0; ok && i < rows.size(); i++) {
+            const EkYerlestirmeRow &row = rows.at(i);
+            for (int column = 0; column < bindings.size(); column++)
+                insert.bindValue(column, bindings.at(column).value(row));
+            for (int key = 0; key < sortKeyBindings.size(); key++) {
+                const QVariant value = bindings.at(sortKeyBindings.at(key)).value(row);
+                insert.bindValue(bindings.size() + key, value.isNull() ? QVariant() : QVariant(StringUtil::toTurkishSortKey(value.toString())));
+            }
+            ok = insert.exec();
+        }
+        if (!ok)
+            qCritical() << "Program yazılamadı:" << insert.lastError().text();
+    }
+
+    if (!ok) {
+        db.rollback();
+        return false;
+    }
+    if (!db.commit()) {
+        qCritical() << "İşlem tamamlanamadı:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool EkYerlestirmeImporter::execute(QSqlQuery &query, const QString &sql) {
+    if (!query.exec(sql)) {
+        qCritical() << "Komut çalıştırılamadı:" << sql << query.lastError().text();
+        return false;
+    }
+    return true;
+}
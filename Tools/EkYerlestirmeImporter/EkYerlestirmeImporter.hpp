@@ -0,0 +1,62 @@
+/*
+EkYerlestirmeImporter class declarations of AcademyScope
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "Core/EkYerlestirmeParser.hpp"
+
+class QSqlQuery;
+
+// Loads the ÖSYM ek yerleştirme exports into the EkTercihDetayli table of
+// YKS.sqlite. The files are parsed concurrently on a thread pool, each into
+// its own arena, then this thread alone writes every row in one transaction
+// through one prepared statement. Programs already in the table are replaced,
+// the later file wins when a program code occurs in more than one file.
+// writeDelta() stores the difference to the table as a ProgramDelta file
+// instead, which the application applies to its copy of the database.
+class EkYerlestirmeImporter
+{
+public:
+    // Result of one parse task
+    struct ParsedFile {
+        QString path;
+        EkYerlestirmeParser::Arena arena;
+        qint64 parseMs = 0;
+        bool ok = false;
+    };
+
+    // threadCount <= 0 uses one thread per core
+    EkYerlestirmeImporter(const QString &databasePath, bool replaceTable, int threadCount = 0);
+    ~EkYerlestirmeImporter();
+
+    bool run(const QStringList &files);
+    bool writeDelta(const QStringList &files, const QString &deltaPath);
+    bool applyDelta(const QString &deltaPath);
+
+private:
+    bool parse(const QStringList &files, QVector<EkYerlestirmeRow> &rows);
+    bool parseFiles(QVector<ParsedFile> &parsedFiles);
+    static QVector<EkYerlestirmeRow> mergeArenas(const QVector<ParsedFile> &parsedFiles);
+    bool open();
+    bool createTable();
+    QStringList tableColumns();
+    bool importedColumns(QList<EkYerlestirmeParser::Column> &columns, QStringList &names);
+    bool write(const QVector<EkYerlestirmeRow> &rows);
+    bool execute(QSqlQuery &query, const QString &sql);
+
+    QString databasePath;
+    bool replaceTable;
+    int threadCount;
+    QString connectionName;
+};
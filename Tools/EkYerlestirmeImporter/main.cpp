@@ -0,0 +1,48 @@
+/*
+Main file of AcademyScope ek yerleştirme importer
+Copyright (C) 2025 Volkan Orhan
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "EkYerlestirmeImporter.hpp"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("AcademyScope ek yerleştirme importer");
+    parser.addHelpOption();
+    parser.addPositionalArgument("database", "YKS.sqlite to write the EkTercihDetayli table of");
+    parser.addPositionalArgument("files", "Tab separated ÖSYM exports, e.g. EkYerlestirme/Tablo3.csv", "<files...>");
+    const QCommandLineOption replaceOption({"r", "replace"}, "Empty EkTercihDetayli before the import");
+    const QCommandLineOption jobsOption({"j", "jobs"}, "Files parsed at the same time, one per core by default", "count", "0");
+    const QCommandLineOption deltaOption({"d", "delta"}, "Write the changes to the table into a delta file instead of importing", "file");
+    const QCommandLineOption applyOption({"a", "apply"}, "Apply a delta file to the database, no export files are read", "file");
+    parser.addOption(replaceOption);
+    parser.addOption(jobsOption);
+    parser.addOption(deltaOption);
+    parser.addOption(applyOption);
+    parser.process(a);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.isEmpty() || (positional.size() < 2 && !parser.isSet(applyOption)))
+        parser.showHelp(2);
+
+    EkYerlestirmeImporter importer(positional.first(), parser.isSet(replaceOption), parser.value(jobsOption).toInt());
+    bool ok;
+    if (parser.isSet(applyOption))
+        ok = importer.applyDelta(parser.value(applyOption));
+    else if (parser.isSet(deltaOption))
+        ok = importer.writeDelta(positional.mid(1), parser.value(deltaOption));
+    else
+        ok = importer.run(positional.mid(1));
+    return ok ? 0 : 1;
+}
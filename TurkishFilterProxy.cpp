@@ -9,6 +9,7 @@ This program is distributed in the hope that it will be useful, but WITHOUT ANY
 You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
 */
 #include "TurkishFilterProxy.hpp"
+#include <utility>
 
 TurkishFilterProxy::TurkishFilterProxy(QObject *parent)
         : QSortFilterProxyModel(parent),
@@ -20,18 +21,91 @@ TurkishFilterProxy::TurkishFilterProxy(QObject *parent)
     }
 
 void TurkishFilterProxy::setNeedle(const QString &s) {
-    needle = turkishLocale.toLower(s);
+    needle = TrigramIndex::turkishFold(s);
+    updateMatches();
     invalidateFilter();
 }
 
+void TurkishFilterProxy::setSourceModel(QAbstractItemModel *model) {
+    for (const QMetaObject::Connection &connection : sourceConnections)
+        disconnect(connection);
+    sourceConnections.clear();
+
+    // Connected before the base class, so the cache is current when the proxy re-filters
+    if (model != nullptr) {
+        sourceConnections = {
+            connect(model, &QAbstractItemModel::modelReset, this, &TurkishFilterProxy::rebuildCache),
+            connect(model, &QAbstractItemModel::layoutChanged, this, &TurkishFilterProxy::rebuildCache),
+            connect(model, &QAbstractItemModel::rowsMoved, this, &TurkishFilterProxy::rebuildCache),
+            connect(model, &QAbstractItemModel::rowsInserted, this, &TurkishFilterProxy::onSourceRowsInserted),
+            connect(model, &QAbstractItemModel::rowsRemoved, this, &TurkishFilterProxy::onSourceRowsRemoved),
+            connect(model, &QAbstractItemModel::dataChanged, this, &TurkishFilterProxy::onSourceDataChanged)
+        };
+    }
+    QSortFilterProxyModel::setSourceModel(model);
+    rebuildCache();
+}
+
+void TurkishFilterProxy::rebuildCache() {
+    foldedTexts.clear();
+    const int rows = sourceModel() != nullptr ? sourceModel()->rowCount() : 0;
+    foldedTexts.reserve(rows);
+    for (int row = 0; row < rows; row++)
+        foldedTexts.append(TrigramIndex::turkishFold(sourceText(row)));
+    rebuildIndex();
+}
+
+void TurkishFilterProxy::onSourceRowsInserted(const QModelIndex &parent, int first, int last) {
+    if (parent.isValid())
+        return;
+    for (int row = first; row <= last; row++)
+        foldedTexts.insert(row, TrigramIndex::turkishFold(sourceText(row)));
+    rebuildIndex();
+}
+
+void TurkishFilterProxy::onSourceRowsRemoved(const QModelIndex &parent, int first, int last) {
+    if (parent.isValid())
+        return;
+    foldedTexts.remove(first, last - first + 1);
+    rebuildIndex();
+}
+
+void TurkishFilterProxy::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+    if (topLeft.parent().isValid() || topLeft.column() > 0)
+        return;
+    for (int row = topLeft.row(); row <= bottomRight.row() && row < foldedTexts.size(); row++)
+        foldedTexts[row] = TrigramIndex::turkishFold(sourceText(row));
+    rebuildIndex();
+}
+
+QString TurkishFilterProxy::sourceText(int row) const {
+    return sourceModel()->index(row, 0).data().toString();
+}
+
+void TurkishFilterProxy::rebuildIndex() {
+    index.build(foldedTexts);
+    updateMatches();
+}
+
+void TurkishFilterProxy::updateMatches() {
+    const int rows = index.size();
+    if (needle.isEmpty()) {
+        matches.fill(1, rows);
+        return;
+    }
+    matches.fill(0, rows);
+    index.find(needle, matchIds);
+    for (int id : std::as_const(matchIds))
+        matches[id] = 1;
+}
+
 bool TurkishFilterProxy::filterAcceptsRow(int row, const QModelIndex &parent) const {
-        const QString hay = turkishLocale.toLower(sourceModel()->index(row, 0, parent).data().toString());
-        return needle.isEmpty() || hay.contains(needle);
+        if (parent.isValid() || row >= matches.size())
+            return needle.isEmpty();
+        return matches.at(row) != 0;
     }
 
 // Türkçe sıralama
 bool TurkishFilterProxy::lessThan(const QModelIndex &l, const QModelIndex &r) const {
-        const QString a = l.data().toString();
-        const QString b = r.data().toString();
-        return collator.compare(a, b) < 0;
+        return collator.compare(l.data().toString(), r.data().toString()) < 0;
 }
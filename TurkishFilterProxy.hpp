@@ -16,23 +16,46 @@ You should have received a copy of the GNU General Public License along with thi
 #include <QCompleter>
 #include <QComboBox>
 #include <QObject>
+#include <QVector>
+#include "Core/TrigramIndex.hpp"
 
+// Keeps the order of the source model unless sort() is called, the catalog
+// lists are filled in Turkish alphabetical order already
 class TurkishFilterProxy : public QSortFilterProxyModel {
     Q_OBJECT
 public:
     explicit TurkishFilterProxy(QObject *parent=nullptr);
 
     void setNeedle(const QString &s);
+    void setSourceModel(QAbstractItemModel *model) override;
 
 protected:
     // contains eşleşmesi (ı/I, i/İ doğru çalışır)
     bool filterAcceptsRow(int row, const QModelIndex &parent) const override;
 
-    // Türkçe sıralama
+    // Türkçe sıralama, only used after sort()
     bool lessThan(const QModelIndex &l, const QModelIndex &r) const override;
 
 private:
+    // Folded strings are computed once per source row and kept in step
+    // with the source model, a keystroke only looks up the needle
+    void rebuildCache();
+    void onSourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void onSourceRowsRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    QString sourceText(int row) const;
+    void rebuildIndex();
+    void updateMatches();
+
     QLocale turkishLocale;
     QCollator collator;
     QString needle;
+    // Per source row
+    QVector<QString> foldedTexts;
+    TrigramIndex index;
+    // One entry per source row, 1 when the row contains the needle
+    QVector<quint8> matches;
+    // Reused by every keystroke
+    QVector<int> matchIds;
+    QList<QMetaObject::Connection> sourceConnections;
 };
@@ -14,7 +14,10 @@ You should have received a copy of the GNU General Public License along with thi
 #include <QFileInfo>
 #include <QSqlDatabase>
 #include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
 #include <QStandardPaths>
+#include <QUrl>
 #include <QDebug>
 
 #include "SQLiteUtil.hpp"
@@ -62,13 +65,82 @@ QString SQLiteUtil::resolveDatabasePath() {
 #endif
 }
 
-QString SQLiteUtil::trOrderExprFor(const QString& col) {
+SQLiteUtil::OpenOptions SQLiteUtil::writableOptions() {
+    return OpenOptions();
+}
+
+SQLiteUtil::OpenOptions SQLiteUtil::readOnlyOptions() {
+    OpenOptions options;
+    options.readOnly = true;
+    options.mmapSize = -1;
+    options.cacheSizeKiB = 64 * 1024;
+    options.tempStoreMemory = true;
+    return options;
+}
+
+SQLiteUtil::OpenOptions SQLiteUtil::defaultOpenOptions() {
+#ifdef ACADEMYSCOPE_READ_ONLY_DATABASE
+    return readOnlyOptions();
+#else
+    return writableOptions();
+#endif
+}
+
+bool SQLiteUtil::openDatabase(QSqlDatabase& db, const QString& path, const OpenOptions& options) {
+    if (options.readOnly) {
+        // immutable=1 can only be given as a URI parameter
+        QUrl uri = QUrl::fromLocalFile(QFileInfo(path).absoluteFilePath());
+        uri.setQuery("immutable=1");
+        db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI");
+        db.setDatabaseName(uri.toString(QUrl::FullyEncoded));
+    }
+    else {
+        db.setConnectOptions(QString());
+        db.setDatabaseName(path);
+    }
+
+    if (!db.open())
+        return false;
+
+    QSqlQuery query(db);
+    const auto pragma = [&query](const QString &sql) {
+        // A rejected pragma only costs performance, the connection stays usable
+        if (!query.exec(sql))
+            qWarning() << "SQLite ayarı uygulanamadı:" << sql << query.lastError().text();
+    };
+
+    if (options.mmapSize != 0) {
+        // SQLite caps the value at its compile-time SQLITE_MAX_MMAP_SIZE
+        const qint64 mmapSize = options.mmapSize < 0 ? QFileInfo(path).size() : options.mmapSize;
+        pragma(QStringLiteral("PRAGMA mmap_size = %1").arg(mmapSize));
+    }
+    if (options.cacheSizeKiB > 0)
+        pragma(QStringLiteral("PRAGMA cache_size = -%1").arg(options.cacheSizeKiB));
+    if (options.tempStoreMemory)
+        pragma("PRAGMA temp_store = MEMORY");
+    if (options.readOnly)
+        pragma("PRAGMA query_only = ON");
+    return true;
+}
+
+QString SQLiteUtil::databaseFilePath(const QSqlDatabase& db) {
+    const QString name = db.databaseName();
+    if (!name.startsWith(QLatin1String("file:")))
+        return name;
+    return QUrl(name).toLocalFile();
+}
+
+QString SQLiteUtil::trOrderExprFor(const QString& col, bool useSortKeyColumns) {
     // Only text columns to be processed
-    if (!(col == "UniversiteAdi" || col == "FakulteYuksekokulAdi" ||
-          col == "ProgramAdi"    || col == "PuanTuru")) {
+    if (!turkishSortedColumns().contains(col)) {
         return col;
     }
 
+    // Indexed key column, ORDER BY becomes an index scan
+    if (useSortKeyColumns) {
+        return sortKeyColumnFor(col);
+    }
+
     struct Map { const char* from; const char* to; };
     static const Map m[] = {
                             {"Ç","CZ"}, {"ç","cz"},
@@ -86,3 +158,23 @@ QString SQLiteUtil::trOrderExprFor(const QString& col) {
     }
     return expr;
 }
+
+const QStringList &SQLiteUtil::turkishSortedColumns() {
+    static const QStringList columns = {"UniversiteAdi", "FakulteYuksekokulAdi", "ProgramAdi", "PuanTuru"};
+    return columns;
+}
+
+QString SQLiteUtil::sortKeyColumnFor(const QString& col) {
+    return col + "SiralamaAnahtari";
+}
+
+bool SQLiteUtil::hasSortKeyColumns(const QSqlDatabase& db, const QString& table) {
+    const QSqlRecord record = db.record(table);
+    if (record.isEmpty())
+        return false;
+    for (const QString &col : turkishSortedColumns()) {
+        if (record.contains(col) && !record.contains(sortKeyColumnFor(col)))
+            return false;
+    }
+    return true;
+}
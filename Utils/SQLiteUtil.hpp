@@ -10,10 +10,44 @@ You should have received a copy of the GNU General Public License along with thi
 */
 #pragma once
 #include <QString>
+#include <QStringList>
+
+class QSqlDatabase;
 
 class SQLiteUtil
 {
 public:
+    // How a connection to the shipped database is opened and tuned
+    struct OpenOptions {
+        // Opens the file with immutable=1 and query_only, SQLite then skips
+        // file locking, journal checks and change detection
+        bool readOnly = false;
+        // PRAGMA mmap_size in bytes, 0 disables memory-mapped I/O, -1 maps the whole file
+        qint64 mmapSize = 0;
+        // PRAGMA cache_size in KiB, 0 keeps SQLite's default
+        int cacheSizeKiB = 0;
+        // PRAGMA temp_store = MEMORY for sorts and temporary indexes
+        bool tempStoreMemory = false;
+    };
+
     static QString resolveDatabasePath();
-    static QString trOrderExprFor(const QString& col);
+
+    // SQLite defaults, the connection can write
+    static OpenOptions writableOptions();
+    // The shipped database is reference data that never changes at run time
+    static OpenOptions readOnlyOptions();
+    // readOnlyOptions() unless the build turned ACADEMYSCOPE_READ_ONLY_DATABASE off
+    static OpenOptions defaultOpenOptions();
+    // Sets the database name and connect options of db, opens it and applies the pragmas
+    static bool openDatabase(QSqlDatabase& db, const QString& path, const OpenOptions& options = defaultOpenOptions());
+    // Local file of db, also when it was opened through a file: URI
+    static QString databaseFilePath(const QSqlDatabase& db);
+
+    // useSortKeyColumns: the table has the materialized sort key columns of the database optimizer
+    static QString trOrderExprFor(const QString& col, bool useSortKeyColumns = false);
+
+    // Text columns that are sorted in Turkish alphabetical order
+    static const QStringList &turkishSortedColumns();
+    static QString sortKeyColumnFor(const QString& col);
+    static bool hasSortKeyColumns(const QSqlDatabase& db, const QString& table);
 };
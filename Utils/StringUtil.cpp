@@ -28,4 +28,35 @@ QString StringUtil::toTurkishUpperCase(const QString &input)
     return turkishLocale.toUpper(input);
 }
 
+QString StringUtil::toTurkishSortKey(const QString &input)
+{
+    // Turkish alphabet, Q W X placed where the collator puts them
+    static const QString alphabet = QStringLiteral("ABCÇDEFGĞHIİJKLMNOÖPQRSŞTUÜVWXYZ");
+    // Letters come after spaces, punctuation and digits, which keep their own code points
+    constexpr ushort letterBase = 0x100;
+    constexpr ushort otherBase = 0x200;
+
+    const QString upper = turkishLocale.toUpper(input);
+    QString key;
+    key.reserve(upper.size());
+    for (QChar c : upper) {
+        // Circumflexed vowels sort as their plain letters
+        switch (c.unicode()) {
+        case 0x00C2: c = QLatin1Char('A'); break;      // Â
+        case 0x00CE: c = QChar(0x0130); break;         // Î
+        case 0x00DB: c = QLatin1Char('U'); break;      // Û
+        default: break;
+        }
+
+        const int letter = alphabet.indexOf(c);
+        if (letter >= 0)
+            key.append(QChar(ushort(letterBase + letter)));
+        else if (c.unicode() < 0x80)
+            key.append(c);
+        else
+            key.append(QChar(ushort(qMin(c.unicode() + otherBase, 0xFFFD))));
+    }
+    return key;
+}
+
 QLocale StringUtil::turkishLocale = QLocale(QLocale::Turkish, QLocale::Turkey);
@@ -18,6 +18,9 @@ class StringUtil
 public:
     static QString toTurkishTitleCase(const QString &input);
     static QString toTurkishUpperCase(const QString &input);
+    // Key whose plain binary (code point) order is the case-insensitive Turkish
+    // alphabetical order of input, e.g. for SQLite's default BINARY collation
+    static QString toTurkishSortKey(const QString &input);
 private:
     static QLocale turkishLocale;
 };
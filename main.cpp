@@ -9,13 +9,24 @@ This program is distributed in the hope that it will be useful, but WITHOUT ANY
 You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
 */
 #include "MainWindow.hpp"
+#include "Core/ProgramDelta.hpp"
+#include "Core/StartupTimeline.hpp"
 
 #include <QApplication>
+#include <QDebug>
 
 int main(int argc, char *argv[])
 {
+    StartupTimeline::start();
     QApplication a(argc, argv);
+    StartupTimeline::mark("application created");
+    // ÖSYM revisions opened with the application are kept and applied at every start
+    for (const QString &argument : a.arguments().mid(1)) {
+        if (argument.endsWith(".delta", Qt::CaseInsensitive) && !ProgramDeltaEngine::install(argument))
+            qDebug() << "Güncelleme dosyası yüklenemedi:" << argument;
+    }
     MainWindow w;
     w.show();
+    StartupTimeline::mark("window shown");
     return a.exec();
 }